@@ -0,0 +1,64 @@
+#include "bloomfilter.h"
+#include "hashpolicies.h"
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+const unsigned BLOCK_BITS = 512;
+
+// Blocking concentrates keys, so the blocks end up less even than a
+// classic filter's bits. A little extra space compensates.
+const double BLOCKING_OVERHEAD = 1.3;
+
+}
+
+BloomFilter::BloomFilter(size_t expectedKeys, double falsePositiveRate) {
+    if (falsePositiveRate <= 0 || falsePositiveRate >= 1) {
+        falsePositiveRate = 0.01;
+    }
+    expectedKeys_ = expectedKeys;
+
+    // Classic sizing: m = -n ln(p) / ln(2)^2 bits and k = (m / n) ln(2).
+    double ln2 = log(2.0);
+    double bitsPerKey = -log(falsePositiveRate) / (ln2 * ln2);
+    double totalBits = max(1.0, expectedKeys * bitsPerKey * BLOCKING_OVERHEAD);
+
+    size_t blockCount = (size_t)ceil(totalBits / BLOCK_BITS);
+    blocks_.assign(blockCount, Block());
+    hashCount_ = (unsigned)max(1.0, round(bitsPerKey * ln2));
+}
+
+void BloomFilter::insert(string_view key) {
+    WyHash hasher;
+    uint64_t hashValue = hasher(key.data(), key.size());
+    Block& block = blocks_[MultiplyShiftReduce()(hashValue, blocks_.size())];
+
+    // Double hashing inside the block: the start comes from the low bits
+    // and the step from a remix, since the high bits chose the block.
+    uint32_t position = (uint32_t)hashValue;
+    uint32_t step = (uint32_t)((hashValue * 0x9E3779B97F4A7C15ULL) >> 40) | 1;
+    for (unsigned i = 0; i < hashCount_; i++) {
+        unsigned bit = position % BLOCK_BITS;
+        block.words[bit / 64] |= (1ULL << (bit % 64));
+        position += step;
+    }
+}
+
+bool BloomFilter::mayContain(string_view key) const {
+    WyHash hasher;
+    uint64_t hashValue = hasher(key.data(), key.size());
+    const Block& block = blocks_[MultiplyShiftReduce()(hashValue, blocks_.size())];
+
+    uint32_t position = (uint32_t)hashValue;
+    uint32_t step = (uint32_t)((hashValue * 0x9E3779B97F4A7C15ULL) >> 40) | 1;
+    for (unsigned i = 0; i < hashCount_; i++) {
+        unsigned bit = position % BLOCK_BITS;
+        if ((block.words[bit / 64] & (1ULL << (bit % 64))) == 0) {
+            return false;
+        }
+        position += step;
+    }
+    return true;
+}
@@ -0,0 +1,51 @@
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using std::size_t;
+using std::string_view;
+using std::vector;
+
+// Cache-line-blocked Bloom filter. Each key picks one 64-byte block and
+// sets all of its bits inside it, so a query costs one cache miss no
+// matter how many hash functions are used. A "no" is always right; a
+// "maybe" is wrong at roughly the configured false-positive rate.
+class BloomFilter {
+    public:
+    BloomFilter(size_t expectedKeys, double falsePositiveRate);
+
+    void insert(string_view key);
+    bool mayContain(string_view key) const;
+
+    size_t blockCount() const {
+        return blocks_.size();
+    }
+
+    unsigned hashCount() const {
+        return hashCount_;
+    }
+
+    size_t memoryBytes() const {
+        return blocks_.size() * sizeof(Block);
+    }
+
+    double bitsPerKey() const {
+        return expectedKeys_ == 0 ? 0 : (double)memoryBytes() * 8 / expectedKeys_;
+    }
+
+    private:
+    struct alignas(64) Block {
+        uint64_t words[8];
+    };
+
+    vector<Block> blocks_;
+    unsigned hashCount_;
+    size_t expectedKeys_;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#include "concurrenthashtable.h"
+
+using namespace std;
+
+ConcurrentHashTable::ConcurrentHashTable(size_t expectedKeys) : size_(0) {
+    bucketCount_ = MaskReduce::bucketCountFor(expectedKeys);
+    buckets_.reset(new atomic<Node*>[bucketCount_]);
+    for (size_t i = 0; i < bucketCount_; i++) {
+        buckets_[i].store(nullptr, memory_order_relaxed);
+    }
+    stripes_.reset(new Stripe[STRIPE_COUNT]);
+}
+
+ConcurrentHashTable::~ConcurrentHashTable() {
+    for (size_t i = 0; i < bucketCount_; i++) {
+        Node* node = buckets_[i].load(memory_order_relaxed);
+        while (node) {
+            Node* next = node->next.load(memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+}
+
+bool ConcurrentHashTable::contains(string_view key) const {
+    uint64_t hashValue = hasher_(key.data(), key.size());
+    EpochReclaimer::Guard guard(epoch_);
+
+    const Node* node = buckets_[indexFor(hashValue)].load(memory_order_acquire);
+    while (node) {
+        if (node->hash == hashValue && node->key == key) {
+            return true;
+        }
+        node = node->next.load(memory_order_acquire);
+    }
+    return false;
+}
+
+bool ConcurrentHashTable::insert(string_view key) {
+    uint64_t hashValue = hasher_(key.data(), key.size());
+    size_t index = indexFor(hashValue);
+    lock_guard<mutex> lock(stripes_[index % STRIPE_COUNT].lock);
+
+    // Holding the stripe lock: no other writer can change this chain.
+    Node* head = buckets_[index].load(memory_order_relaxed);
+    for (Node* node = head; node; node = node->next.load(memory_order_relaxed)) {
+        if (node->hash == hashValue && node->key == key) {
+            return false;
+        }
+    }
+
+    // The node is fully built before the release store makes it visible.
+    buckets_[index].store(new Node(key, hashValue, head), memory_order_release);
+    size_.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+bool ConcurrentHashTable::erase(string_view key) {
+    uint64_t hashValue = hasher_(key.data(), key.size());
+    size_t index = indexFor(hashValue);
+    lock_guard<mutex> lock(stripes_[index % STRIPE_COUNT].lock);
+
+    atomic<Node*>* link = &buckets_[index];
+    Node* node = link->load(memory_order_relaxed);
+    while (node) {
+        if (node->hash == hashValue && node->key == key) {
+            // Readers already on this node can still follow its next link.
+            link->store(node->next.load(memory_order_relaxed), memory_order_release);
+            epoch_.retire(node);
+            size_.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+        link = &node->next;
+        node = link->load(memory_order_relaxed);
+    }
+    return false;
+}
@@ -0,0 +1,77 @@
+#ifndef CONCURRENTHASHTABLE_H
+#define CONCURRENTHASHTABLE_H
+
+#include "epoch.h"
+#include "hashpolicies.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+
+// Chained hash set that many threads can share. Lookups take no locks:
+// they pin an epoch and walk singly linked chains whose links are
+// published with release stores. Inserts and erases lock one of a fixed
+// set of stripes, and erased nodes are handed to the epoch reclaimer
+// rather than deleted while a reader may still be on them.
+//
+// The bucket array is sized once from the expected key count and does
+// not grow, because resizing under lock-free readers would need its own
+// migration protocol.
+class ConcurrentHashTable {
+    public:
+    explicit ConcurrentHashTable(size_t expectedKeys);
+    ~ConcurrentHashTable();
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    bool insert(string_view key);
+    bool contains(string_view key) const;
+    bool erase(string_view key);
+
+    size_t size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    size_t bucketCount() const {
+        return bucketCount_;
+    }
+
+    // Writer lock stripes; buckets map onto stripes by index.
+    static const size_t STRIPE_COUNT = 64;
+
+    private:
+    struct Node {
+        std::atomic<Node*> next;
+        uint64_t hash;
+        const string key;
+
+        Node(string_view keyValue, uint64_t hashValue, Node* nextNode)
+            : next(nextNode), hash(hashValue), key(keyValue) {}
+    };
+
+    struct alignas(64) Stripe {
+        std::mutex lock;
+    };
+
+    size_t bucketCount_;
+    std::unique_ptr<std::atomic<Node*>[]> buckets_;
+    std::unique_ptr<Stripe[]> stripes_;
+    std::atomic<size_t> size_;
+    mutable EpochReclaimer epoch_;
+    WyHash hasher_;
+    MaskReduce reducer_;
+
+    size_t indexFor(uint64_t hashValue) const {
+        return reducer_(hashValue, bucketCount_);
+    }
+};
+
+#endif
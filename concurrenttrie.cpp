@@ -0,0 +1,223 @@
+#include "concurrenttrie.h"
+#include <algorithm>
+#include <new>
+
+using namespace std;
+
+const ConcurrentTrie::Node* ConcurrentTrie::Node::find(char c) const {
+    const char* keyArray = keys();
+    for (size_t i = 0; i < count; i++) {
+        if ((unsigned char)keyArray[i] >= (unsigned char)c) {
+            return keyArray[i] == c ? links()[i] : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+ConcurrentTrie::Node* ConcurrentTrie::allocate(size_t count, bool endOfWord) {
+    Node* node = static_cast<Node*>(::operator new(sizeof(Node) + count * (sizeof(Node*) + 1)));
+    node->count = (uint16_t)count;
+    node->endOfWord = endOfWord;
+    return node;
+}
+
+void ConcurrentTrie::release(void* node) {
+    ::operator delete(node);
+}
+
+void ConcurrentTrie::destroyTree(const Node* node) {
+    for (size_t i = 0; i < node->count; i++) {
+        destroyTree(node->links()[i]);
+    }
+    release(const_cast<Node*>(node));
+}
+
+ConcurrentTrie::Node* ConcurrentTrie::copyOf(const Node* node) {
+    Node* copy = allocate(node->count, node->endOfWord);
+    copy_n(node->links(), node->count, copy->links());
+    copy_n(node->keys(), node->count, copy->keys());
+    return copy;
+}
+
+ConcurrentTrie::Node* ConcurrentTrie::copyWithChild(const Node* node, char c, const Node* child) {
+    const char* keys = node->keys();
+    size_t position = 0;
+    while (position < node->count && (unsigned char)keys[position] < (unsigned char)c) {
+        position++;
+    }
+    bool present = position < node->count && keys[position] == c;
+
+    size_t count = node->count + (child && !present ? 1 : 0) - (!child && present ? 1 : 0);
+    Node* copy = allocate(count, node->endOfWord);
+    size_t out = 0;
+    for (size_t i = 0; i <= node->count; i++) {
+        if (i == position && child) {
+            copy->links()[out] = child;
+            copy->keys()[out] = c;
+            out++;
+        }
+        if (i == node->count) {
+            break;
+        }
+        if (i == position && present) {
+            continue;
+        }
+        copy->links()[out] = node->links()[i];
+        copy->keys()[out] = keys[i];
+        out++;
+    }
+    return copy;
+}
+
+const ConcurrentTrie::Node* ConcurrentTrie::build(const vector<string_view>& keys, size_t begin, size_t end,
+                                                  size_t depth) {
+    // Sorted order puts the word that ends here first.
+    bool endsHere = begin < end && keys[begin].size() == depth;
+    size_t first = endsHere ? begin + 1 : begin;
+
+    size_t count = 0;
+    for (size_t i = first; i < end; i++) {
+        if (i == first || keys[i][depth] != keys[i - 1][depth]) {
+            count++;
+        }
+    }
+
+    Node* node = allocate(count, endsHere);
+    size_t i = first;
+    for (size_t slot = 0; slot < count; slot++) {
+        size_t childEnd = i + 1;
+        while (childEnd < end && keys[childEnd][depth] == keys[i][depth]) {
+            childEnd++;
+        }
+        node->keys()[slot] = keys[i][depth];
+        node->links()[slot] = build(keys, i, childEnd, depth + 1);
+        i = childEnd;
+    }
+    return node;
+}
+
+ConcurrentTrie::ConcurrentTrie() : root_(allocate(0, false)), size_(0) {
+}
+
+ConcurrentTrie::ConcurrentTrie(const vector<string_view>& words) : size_(0) {
+    vector<string_view> keys(words.begin(), words.end());
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    root_.store(build(keys, 0, keys.size(), 0), memory_order_relaxed);
+    size_.store(keys.size(), memory_order_relaxed);
+}
+
+ConcurrentTrie::~ConcurrentTrie() {
+    // No reader may still be inside an operation; retired nodes go with
+    // the reclaimer.
+    destroyTree(root_.load(memory_order_relaxed));
+}
+
+void ConcurrentTrie::pathTo(string_view word, vector<const Node*>& path) const {
+    const Node* node = root_.load(memory_order_relaxed);
+    path.push_back(node);
+    for (char c : word) {
+        node = node->find(c);
+        if (!node) {
+            return;
+        }
+        path.push_back(node);
+    }
+}
+
+void ConcurrentTrie::publish(const Node* root, const vector<const Node*>& replaced) {
+    // The copies are complete before the release store makes them
+    // reachable. The old path can be retired only after it is unlinked.
+    root_.store(root, memory_order_release);
+    for (const Node* node : replaced) {
+        epoch_.retire(const_cast<Node*>(node), release);
+    }
+}
+
+bool ConcurrentTrie::insert(string_view word) {
+    lock_guard<mutex> lock(writeMutex_);
+
+    // Only writers store to root_, and they hold the lock.
+    vector<const Node*> path;
+    pathTo(word, path);
+    size_t depth = path.size() - 1;
+    if (depth == word.size() && path.back()->endOfWord) {
+        return false;
+    }
+
+    // Replacement for the deepest existing node: a copy marked as a word,
+    // or a copy linked to a fresh chain for the missing suffix.
+    Node* replacement;
+    if (depth == word.size()) {
+        replacement = copyOf(path.back());
+        replacement->endOfWord = true;
+    } else {
+        const Node* chain = allocate(0, true);
+        for (size_t i = word.size() - 1; i > depth; i--) {
+            Node* parent = allocate(1, false);
+            parent->links()[0] = chain;
+            parent->keys()[0] = word[i];
+            chain = parent;
+        }
+        replacement = copyWithChild(path.back(), word[depth], chain);
+    }
+
+    for (size_t i = depth; i-- > 0;) {
+        replacement = copyWithChild(path[i], word[i], replacement);
+    }
+    publish(replacement, path);
+    size_.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+bool ConcurrentTrie::remove(string_view word) {
+    lock_guard<mutex> lock(writeMutex_);
+
+    vector<const Node*> path;
+    pathTo(word, path);
+    if (path.size() != word.size() + 1 || !path.back()->endOfWord) {
+        return false;
+    }
+
+    // Unmark the word's node, or drop it when nothing hangs below it;
+    // ancestors left with no word and no child are dropped as well.
+    Node* replacement = nullptr;
+    if (path.back()->count > 0) {
+        replacement = copyOf(path.back());
+        replacement->endOfWord = false;
+    }
+    for (size_t i = word.size(); i-- > 0;) {
+        const Node* parent = path[i];
+        if (!replacement && i > 0 && parent->count == 1 && !parent->endOfWord) {
+            continue;
+        }
+        replacement = copyWithChild(parent, word[i], replacement);
+    }
+    publish(replacement, path);
+    size_.fetch_sub(1, memory_order_relaxed);
+    return true;
+}
+
+bool ConcurrentTrie::search(string_view word) const {
+    EpochReclaimer::Guard guard(epoch_);
+    const Node* node = root_.load(memory_order_acquire);
+    for (char c : word) {
+        node = node->find(c);
+        if (!node) {
+            return false;
+        }
+    }
+    return node->endOfWord;
+}
+
+bool ConcurrentTrie::startsWith(string_view prefix) const {
+    EpochReclaimer::Guard guard(epoch_);
+    const Node* node = root_.load(memory_order_acquire);
+    for (char c : prefix) {
+        node = node->find(c);
+        if (!node) {
+            return false;
+        }
+    }
+    return true;
+}
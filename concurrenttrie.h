@@ -0,0 +1,106 @@
+#ifndef CONCURRENTTRIE_H
+#define CONCURRENTTRIE_H
+
+#include "epoch.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+// Trie that any number of threads can read while writers change it,
+// RCU style. Published nodes are never modified. A writer copies the
+// nodes on the path it changes, links the copies to the untouched
+// subtrees, and publishes the new root with one release store. Readers
+// pin an epoch, load the root once and walk an immutable snapshot with
+// no locks and no stores to shared memory. The replaced path nodes are
+// retired to the epoch reclaimer and freed once no reader can hold them.
+//
+// Writers are serialized by a mutex; each write allocates about one node
+// per character of the word.
+class ConcurrentTrie {
+    public:
+    ConcurrentTrie();
+
+    // Builds the first snapshot directly from the distinct words, without
+    // a path copy per word.
+    explicit ConcurrentTrie(const vector<string_view>& words);
+    ~ConcurrentTrie();
+
+    ConcurrentTrie(const ConcurrentTrie&) = delete;
+    ConcurrentTrie& operator=(const ConcurrentTrie&) = delete;
+
+    // Return false when the word was already present / absent.
+    bool insert(string_view word);
+    bool remove(string_view word);
+
+    bool search(string_view word) const;
+    bool startsWith(string_view prefix) const;
+
+    size_t size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    // Nodes retired by writers and not yet freed.
+    size_t pendingReclaim() const {
+        return epoch_.pendingCount();
+    }
+
+    private:
+    // A node and its child table share one allocation: the header, then
+    // count links, then count keys in ascending order.
+    struct alignas(void*) Node {
+        uint16_t count;
+        bool endOfWord;
+
+        const Node** links() {
+            return reinterpret_cast<const Node**>(this + 1);
+        }
+
+        const Node* const* links() const {
+            return reinterpret_cast<const Node* const*>(this + 1);
+        }
+
+        char* keys() {
+            return reinterpret_cast<char*>(links() + count);
+        }
+
+        const char* keys() const {
+            return reinterpret_cast<const char*>(links() + count);
+        }
+
+        const Node* find(char c) const;
+    };
+
+    std::atomic<const Node*> root_;
+    std::atomic<size_t> size_;
+    std::mutex writeMutex_;
+    mutable EpochReclaimer epoch_;
+
+    static Node* allocate(size_t count, bool endOfWord);
+    static void release(void* node);
+    static void destroyTree(const Node* node);
+
+    static Node* copyOf(const Node* node);
+
+    // Copy of node with the child on c replaced by child, added if absent,
+    // or dropped if child is null.
+    static Node* copyWithChild(const Node* node, char c, const Node* child);
+
+    static const Node* build(const vector<string_view>& keys, size_t begin, size_t end, size_t depth);
+
+    // Nodes along word from the root, as far as they exist.
+    void pathTo(string_view word, vector<const Node*>& path) const;
+
+    // Makes root the current snapshot and retires the nodes it replaced.
+    void publish(const Node* root, const vector<const Node*>& replaced);
+};
+
+#endif
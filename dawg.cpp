@@ -0,0 +1,153 @@
+#include "dawg.h"
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+
+// A state while the automaton is being built. Transitions are appended in
+// label order because the words arrive sorted.
+struct BuildState {
+    bool final;
+    vector<pair<char, uint32_t>> transitions;
+
+    BuildState() : final(false) {}
+};
+
+// Two states are equivalent when they agree on finality and on every
+// transition, so that is the register key.
+string signatureOf(const BuildState& state) {
+    string signature(1, state.final ? '1' : '0');
+    for (const auto& transition : state.transitions) {
+        signature += transition.first;
+        signature.append(reinterpret_cast<const char*>(&transition.second), sizeof(uint32_t));
+    }
+    return signature;
+}
+
+}
+
+Dawg::Dawg(const vector<string_view>& words) {
+    vector<string_view> keys(words.begin(), words.end());
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    wordCount_ = keys.size();
+
+    vector<BuildState> states(1);
+    unordered_map<string, uint32_t> registry;
+    // A state replaced by its registered equivalent is unreachable, so its
+    // slot is handed to the next new state. The build then holds about as
+    // many states as the finished automaton, not a whole trie.
+    vector<uint32_t> freeStates;
+    trieStates_ = 1;
+
+    // path[i] is the state after the first i characters of the previous
+    // word. Everything below the shared prefix with the next word can no
+    // longer gain transitions, so it is minimized before moving on.
+    vector<uint32_t> path(1, 0);
+    string_view previous;
+
+    auto minimizeDownTo = [&](size_t depth) {
+        for (size_t i = path.size() - 1; i > depth; i--) {
+            uint32_t child = path[i];
+            string signature = signatureOf(states[child]);
+            auto found = registry.find(signature);
+            if (found != registry.end()) {
+                states[path[i - 1]].transitions.back().second = found->second;
+                states[child] = BuildState();
+                freeStates.push_back(child);
+            } else {
+                registry.emplace(signature, child);
+            }
+        }
+        path.resize(depth + 1);
+    };
+
+    for (string_view word : keys) {
+        size_t common = 0;
+        while (common < word.size() && common < previous.size() && word[common] == previous[common]) {
+            common++;
+        }
+        minimizeDownTo(common);
+
+        for (size_t i = common; i < word.size(); i++) {
+            uint32_t next;
+            if (!freeStates.empty()) {
+                next = freeStates.back();
+                freeStates.pop_back();
+            } else {
+                next = (uint32_t)states.size();
+                states.push_back(BuildState());
+            }
+            trieStates_++;
+            states[path.back()].transitions.push_back(make_pair(word[i], next));
+            path.push_back(next);
+        }
+        states[path.back()].final = true;
+        previous = word;
+    }
+    minimizeDownTo(0);
+    buildPeakStates_ = states.size();
+
+    // Pack the states still reachable from the start state, numbered in
+    // breadth-first order.
+    vector<int64_t> renumbered(states.size(), -1);
+    vector<uint32_t> order(1, 0);
+    renumbered[0] = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        for (const auto& transition : states[order[i]].transitions) {
+            if (renumbered[transition.second] < 0) {
+                renumbered[transition.second] = (int64_t)order.size();
+                order.push_back(transition.second);
+            }
+        }
+    }
+
+    firstTransition_.reserve(order.size() + 1);
+    final_.resize(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        const BuildState& state = states[order[i]];
+        firstTransition_.push_back((uint32_t)labels_.size());
+        final_[i] = state.final;
+        for (const auto& transition : state.transitions) {
+            labels_.push_back(transition.first);
+            targets_.push_back((uint32_t)renumbered[transition.second]);
+        }
+    }
+    firstTransition_.push_back((uint32_t)labels_.size());
+    labels_.shrink_to_fit();
+    targets_.shrink_to_fit();
+}
+
+int64_t Dawg::walk(string_view text) const {
+    uint32_t state = 0;
+    for (char c : text) {
+        uint32_t end = firstTransition_[state + 1];
+        uint32_t i = firstTransition_[state];
+        while (i < end && labels_[i] != c) {
+            i++;
+        }
+        if (i == end) {
+            return -1;
+        }
+        state = targets_[i];
+    }
+    return state;
+}
+
+bool Dawg::search(string_view word) const {
+    int64_t state = walk(word);
+    return state >= 0 && final_[state];
+}
+
+bool Dawg::startsWith(string_view prefix) const {
+    return walk(prefix) >= 0;
+}
+
+size_t Dawg::memoryBytes() const {
+    return firstTransition_.capacity() * sizeof(uint32_t)
+         + labels_.capacity()
+         + targets_.capacity() * sizeof(uint32_t)
+         + final_.capacity() / 8;
+}
@@ -0,0 +1,70 @@
+#ifndef DAWG_H
+#define DAWG_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+// Minimal acyclic word automaton (DAWG). A trie shares prefixes; a DAWG
+// also shares suffixes, so "-ing" or "-ness" endings are stored once.
+// Built with Daciuk's incremental algorithm over the sorted words: once a
+// word's path is no longer a prefix of the next word, its states are
+// minimized bottom-up against a register of equivalent states. The result
+// is read-only and packed into flat arrays.
+class Dawg {
+    public:
+    // Builds over the distinct words (duplicates are dropped).
+    explicit Dawg(const vector<string_view>& words);
+
+    bool search(string_view word) const;
+    bool startsWith(string_view prefix) const;
+
+    size_t size() const {
+        return wordCount_;
+    }
+
+    size_t stateCount() const {
+        return firstTransition_.size() - 1;
+    }
+
+    size_t transitionCount() const {
+        return labels_.size();
+    }
+
+    // States the build created before minimization, which is exactly the
+    // node count of a trie over the same words.
+    size_t trieStateCount() const {
+        return trieStates_;
+    }
+
+    // Most states the build held at once; replaced states are recycled.
+    size_t buildPeakStates() const {
+        return buildPeakStates_;
+    }
+
+    // Bytes held by the packed automaton.
+    size_t memoryBytes() const;
+
+    private:
+    // Transitions of state s are [firstTransition_[s], firstTransition_[s + 1]).
+    vector<uint32_t> firstTransition_;
+    vector<char> labels_;
+    vector<uint32_t> targets_;
+    vector<bool> final_;
+    size_t wordCount_;
+    size_t trieStates_;
+    size_t buildPeakStates_;
+
+    // Returns the state reached by reading text from the start state, or
+    // -1 if the automaton has no such path.
+    int64_t walk(string_view text) const;
+};
+
+#endif
@@ -0,0 +1,173 @@
+#include "doublearraytrie.h"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+// CHECK value of a cell that holds no node.
+const int32_t FREE_CELL = -1;
+
+// Once this share of the cells between the search start and the chosen
+// base is taken, later searches start at the chosen base instead.
+const double DENSE_ENOUGH = 0.95;
+
+// A node still to be placed: the sorted words [begin, end) all share
+// their first depth characters, and cell is where the node lives.
+struct PendingNode {
+    size_t begin;
+    size_t end;
+    size_t depth;
+    int32_t cell;
+};
+
+}
+
+DoubleArrayTrie::DoubleArrayTrie(const vector<string>& words) : usedCells_(1) {
+    vector<string_view> keys(words.begin(), words.end());
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    wordCount_ = keys.size();
+
+    base_.assign(1024, 0);
+    check_.assign(1024, FREE_CELL);
+    check_[0] = 0;
+    vector<bool> baseTaken(1024, false);
+    vector<bool> terminal(1024, false);
+
+    auto growTo = [&](size_t size) {
+        if (size <= base_.size()) {
+            return;
+        }
+        size_t grown = max(size, base_.size() * 2);
+        base_.resize(grown, 0);
+        check_.resize(grown, FREE_CELL);
+        baseTaken.resize(grown, false);
+        terminal.resize(grown, false);
+    };
+
+    size_t searchStart = 1;
+    vector<PendingNode> pending;
+    pending.push_back(PendingNode{0, keys.size(), 0, 0});
+    vector<int32_t> codes;
+    vector<size_t> childBegin;
+
+    while (!pending.empty()) {
+        PendingNode node = pending.back();
+        pending.pop_back();
+
+        // Sorted order puts the word that ends here first.
+        size_t first = node.begin;
+        if (first < node.end && keys[first].size() == node.depth) {
+            terminal[node.cell] = true;
+            first++;
+        }
+
+        codes.clear();
+        childBegin.clear();
+        for (size_t i = first; i < node.end; i++) {
+            int32_t code = codeOf(keys[i][node.depth]);
+            if (codes.empty() || codes.back() != code) {
+                codes.push_back(code);
+                childBegin.push_back(i);
+            }
+        }
+        if (codes.empty()) {
+            continue;
+        }
+        childBegin.push_back(node.end);
+
+        // Find the lowest base whose child cells are all free, scanning
+        // free cells from searchStart for a spot for the first child.
+        size_t position = max((size_t)codes[0], searchStart);
+        size_t firstFree = 0;
+        size_t taken = 0;
+        int32_t base;
+        while (true) {
+            growTo(position + 1);
+            if (check_[position] != FREE_CELL) {
+                taken++;
+                position++;
+                continue;
+            }
+            if (firstFree == 0) {
+                firstFree = position;
+            }
+
+            base = (int32_t)(position - codes[0]);
+            growTo((size_t)base + codes.back() + 1);
+            bool fits = !baseTaken[base];
+            for (size_t c = 1; fits && c < codes.size(); c++) {
+                fits = check_[base + codes[c]] == FREE_CELL;
+            }
+            if (fits) {
+                break;
+            }
+            position++;
+        }
+        if (taken >= DENSE_ENOUGH * (position - searchStart + 1)) {
+            searchStart = position;
+        } else if (firstFree > searchStart) {
+            searchStart = firstFree;
+        }
+
+        if ((size_t)base + codes.back() > (size_t)INT32_MAX) {
+            throw length_error("DoubleArrayTrie: too many cells for 32-bit indices");
+        }
+        base_[node.cell] = base;
+        baseTaken[base] = true;
+        for (size_t c = 0; c < codes.size(); c++) {
+            check_[base + codes[c]] = node.cell;
+        }
+        usedCells_ += codes.size();
+        for (size_t c = 0; c < codes.size(); c++) {
+            pending.push_back(PendingNode{childBegin[c], childBegin[c + 1], node.depth + 1, base + codes[c]});
+        }
+    }
+
+    // Drop the unused tail left by doubling.
+    size_t used = base_.size();
+    while (used > 1 && check_[used - 1] == FREE_CELL) {
+        used--;
+    }
+    base_.resize(used);
+    check_.resize(used);
+    base_.shrink_to_fit();
+    check_.shrink_to_fit();
+
+    terminal_.assign((used + 63) / 64, 0);
+    for (size_t cell = 0; cell < used; cell++) {
+        if (terminal[cell]) {
+            terminal_[cell >> 6] |= 1ULL << (cell & 63);
+        }
+    }
+}
+
+int32_t DoubleArrayTrie::walk(string_view text) const {
+    int32_t cell = 0;
+    size_t size = base_.size();
+    for (char c : text) {
+        size_t next = (size_t)(base_[cell] + codeOf(c));
+        if (next >= size || check_[next] != cell) {
+            return -1;
+        }
+        cell = (int32_t)next;
+    }
+    return cell;
+}
+
+bool DoubleArrayTrie::search(string_view word) const {
+    int32_t cell = walk(word);
+    return cell >= 0 && isTerminal(cell);
+}
+
+bool DoubleArrayTrie::startsWith(string_view prefix) const {
+    return walk(prefix) >= 0;
+}
+
+size_t DoubleArrayTrie::memoryBytes() const {
+    return base_.capacity() * sizeof(int32_t)
+         + check_.capacity() * sizeof(int32_t)
+         + terminal_.capacity() * sizeof(uint64_t);
+}
@@ -0,0 +1,64 @@
+#ifndef DOUBLEARRAYTRIE_H
+#define DOUBLEARRAYTRIE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+// Read-only trie in Aoe's double-array form. Every node is a cell index;
+// the child of node s on character c is t = BASE[s] + code(c), and the
+// transition exists only if CHECK[t] == s. A step down the tree is two
+// array reads with no search and no hashing. A bitmap marks the cells that
+// end a word.
+class DoubleArrayTrie {
+    public:
+    // Builds over the distinct words (duplicates are dropped).
+    explicit DoubleArrayTrie(const vector<string>& words);
+
+    bool search(string_view word) const;
+    bool startsWith(string_view prefix) const;
+
+    size_t size() const {
+        return wordCount_;
+    }
+
+    // Cells in the arrays, and how many of them hold a node.
+    size_t cellCount() const {
+        return base_.size();
+    }
+
+    size_t usedCells() const {
+        return usedCells_;
+    }
+
+    // Bytes held by BASE, CHECK and the terminal bitmap.
+    size_t memoryBytes() const;
+
+    private:
+    vector<int32_t> base_;
+    vector<int32_t> check_;
+    vector<uint64_t> terminal_;
+    size_t wordCount_;
+    size_t usedCells_;
+
+    // Character codes start at 1, so BASE[s] + code never lands on the root.
+    static int32_t codeOf(char c) {
+        return (int32_t)(unsigned char)c + 1;
+    }
+
+    bool isTerminal(size_t cell) const {
+        return (terminal_[cell >> 6] >> (cell & 63)) & 1;
+    }
+
+    // Returns the cell reached by reading text from the root, or -1.
+    int32_t walk(string_view text) const;
+};
+
+#endif
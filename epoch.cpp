@@ -0,0 +1,133 @@
+#include "epoch.h"
+
+using namespace std;
+
+namespace {
+
+// Each live thread owns one slot index, shared by every reclaimer. The
+// lowest free index is handed out, so the slots in use stay packed into
+// the first blocks. Taken once per thread, so a mutex is cheap enough.
+mutex slotMutex;
+vector<bool> slotTaken;
+
+struct ThreadSlot {
+    size_t index;
+
+    ThreadSlot() {
+        lock_guard<mutex> lock(slotMutex);
+        for (index = 0; index < slotTaken.size() && slotTaken[index]; index++) {
+        }
+        if (index == slotTaken.size()) {
+            slotTaken.push_back(false);
+        }
+        slotTaken[index] = true;
+    }
+
+    ~ThreadSlot() {
+        lock_guard<mutex> lock(slotMutex);
+        slotTaken[index] = false;
+    }
+};
+
+}
+
+size_t EpochReclaimer::currentThreadSlot() {
+    thread_local ThreadSlot slot;
+    return slot.index;
+}
+
+EpochReclaimer::AnnouncementBlock::AnnouncementBlock() : next(nullptr) {
+    for (size_t i = 0; i < BLOCK_SLOTS; i++) {
+        slots[i].epoch.store(INACTIVE, memory_order_relaxed);
+    }
+}
+
+EpochReclaimer::EpochReclaimer() : globalEpoch_(0), retiresSinceAdvance_(0) {
+}
+
+EpochReclaimer::~EpochReclaimer() {
+    // No reader may be pinned once the owner is being destroyed.
+    for (size_t i = 0; i < 3; i++) {
+        freeList(limbo_[i]);
+    }
+    AnnouncementBlock* block = announcements_.next.load();
+    while (block) {
+        AnnouncementBlock* next = block->next.load();
+        delete block;
+        block = next;
+    }
+}
+
+EpochReclaimer::Announcement& EpochReclaimer::announcementFor(size_t slot) {
+    AnnouncementBlock* block = &announcements_;
+    for (; slot >= BLOCK_SLOTS; slot -= BLOCK_SLOTS) {
+        AnnouncementBlock* next = block->next.load(memory_order_acquire);
+        if (!next) {
+            // Another thread may link a block first; then use theirs.
+            AnnouncementBlock* fresh = new AnnouncementBlock();
+            if (block->next.compare_exchange_strong(next, fresh)) {
+                next = fresh;
+            } else {
+                delete fresh;
+            }
+        }
+        block = next;
+    }
+    return block->slots[slot];
+}
+
+EpochReclaimer::Guard::Guard(EpochReclaimer& owner)
+    : owner_(owner), announcement_(&owner.announcementFor(currentThreadSlot()).epoch) {
+    // seq_cst so the announcement is visible before any shared pointer is read
+    uint64_t epoch = owner_.globalEpoch_.load();
+    announcement_->store(epoch);
+}
+
+EpochReclaimer::Guard::~Guard() {
+    announcement_->store(INACTIVE, memory_order_release);
+}
+
+void EpochReclaimer::retire(void* object, void (*deleter)(void*)) {
+    lock_guard<mutex> lock(retireMutex_);
+
+    uint64_t epoch = globalEpoch_.load();
+    limbo_[epoch % 3].push_back(Retired{object, deleter});
+
+    retiresSinceAdvance_ += 1;
+    if (retiresSinceAdvance_ >= ADVANCE_INTERVAL) {
+        retiresSinceAdvance_ = 0;
+        tryAdvance();
+    }
+}
+
+size_t EpochReclaimer::pendingCount() const {
+    lock_guard<mutex> lock(retireMutex_);
+    return limbo_[0].size() + limbo_[1].size() + limbo_[2].size();
+}
+
+void EpochReclaimer::tryAdvance() {
+    uint64_t epoch = globalEpoch_.load();
+
+    // A block linked after this walk passes it can only hold readers that
+    // announced after this load, just like an INACTIVE slot read here.
+    for (const AnnouncementBlock* block = &announcements_; block; block = block->next.load()) {
+        for (size_t i = 0; i < BLOCK_SLOTS; i++) {
+            uint64_t announced = block->slots[i].epoch.load();
+            if (announced != INACTIVE && announced != epoch) {
+                return;
+            }
+        }
+    }
+
+    // Every pinned reader is in the current epoch, so nothing retired two
+    // epochs ago can still be reachable from a reader.
+    globalEpoch_.store(epoch + 1);
+    freeList(limbo_[(epoch + 1) % 3]);
+}
+
+void EpochReclaimer::freeList(vector<Retired>& list) {
+    for (size_t i = 0; i < list.size(); i++) {
+        list[i].deleter(list[i].object);
+    }
+    list.clear();
+}
@@ -0,0 +1,93 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+using std::size_t;
+
+// Epoch-based reclamation for structures whose readers take no locks.
+// A reader pins the current epoch for the length of one operation. A
+// writer that unlinks a node retires it instead of deleting it, and the
+// node is freed once every reader that might still hold it has unpinned,
+// i.e. two epoch advances later. Any number of threads may take part:
+// announcement slots are added a block at a time as threads arrive.
+class EpochReclaimer {
+    public:
+    // Unpins on destruction. Not reentrant: one guard per thread at a time.
+    class Guard {
+        public:
+        explicit Guard(EpochReclaimer& owner);
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        private:
+        EpochReclaimer& owner_;
+        std::atomic<uint64_t>* announcement_;
+    };
+
+    EpochReclaimer();
+    ~EpochReclaimer();
+
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    // Frees object with deleter once no pinned reader can still see it.
+    void retire(void* object, void (*deleter)(void*));
+
+    template <typename T>
+    void retire(T* object) {
+        retire(object, [](void* pointer) { delete static_cast<T*>(pointer); });
+    }
+
+    // Objects retired but not yet freed.
+    size_t pendingCount() const;
+
+    private:
+    struct alignas(64) Announcement {
+        std::atomic<uint64_t> epoch;
+    };
+
+    // Slots per block of announcements.
+    static const size_t BLOCK_SLOTS = 64;
+
+    // Blocks are linked once and never removed, so readers walk the list
+    // without locking.
+    struct AnnouncementBlock {
+        Announcement slots[BLOCK_SLOTS];
+        std::atomic<AnnouncementBlock*> next;
+
+        AnnouncementBlock();
+    };
+
+    struct Retired {
+        void* object;
+        void (*deleter)(void*);
+    };
+
+    // Announcement value of a thread that is not inside an operation.
+    static const uint64_t INACTIVE = ~0ULL;
+
+    // Retires between attempts to advance the global epoch.
+    static const size_t ADVANCE_INTERVAL = 64;
+
+    AnnouncementBlock announcements_;
+    std::atomic<uint64_t> globalEpoch_;
+
+    mutable std::mutex retireMutex_;
+    std::vector<Retired> limbo_[3];
+    size_t retiresSinceAdvance_;
+
+    static size_t currentThreadSlot();
+    // The announcement for slot, linking in blocks up to it if needed.
+    Announcement& announcementFor(size_t slot);
+    void tryAdvance();
+    void freeList(std::vector<Retired>& list);
+};
+
+#endif
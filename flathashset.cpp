@@ -0,0 +1,226 @@
+#include "flathashset.h"
+#include <functional>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLATHASHSET_SSE2 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const int8_t CTRL_EMPTY = -128;   // 0b10000000
+const int8_t CTRL_DELETED = -2;   // 0b11111110
+
+// Full slots store h2, the low 7 bits of the hash, so their control
+// byte is always non-negative.
+inline int8_t h2(size_t hashValue) {
+    return (int8_t)(hashValue & 0x7F);
+}
+
+inline size_t h1(size_t hashValue) {
+    return hashValue >> 7;
+}
+
+inline unsigned lowestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+// Bit i of the result is set when control byte i of the group equals value.
+inline uint32_t matchByte(const int8_t* group, int8_t value) {
+#ifdef FLATHASHSET_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    __m128i match = _mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value));
+    return (uint32_t)_mm_movemask_epi8(match);
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < FlatHashSet::GROUP_WIDTH; i++) {
+        if (group[i] == value) {
+            mask |= (1u << i);
+        }
+    }
+    return mask;
+#endif
+}
+
+// Empty and deleted are the only control bytes with the sign bit set.
+inline uint32_t matchEmptyOrDeleted(const int8_t* group) {
+#ifdef FLATHASHSET_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(ctrl);
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < FlatHashSet::GROUP_WIDTH; i++) {
+        if (group[i] < 0) {
+            mask |= (1u << i);
+        }
+    }
+    return mask;
+#endif
+}
+
+size_t roundUpToGroups(size_t capacity) {
+    size_t result = FlatHashSet::GROUP_WIDTH;
+    while (result < capacity) {
+        result *= 2;
+    }
+    return result;
+}
+
+// Keep the table at most 7/8 full.
+size_t maxLoad(size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+}
+
+FlatHashSet::FlatHashSet(size_t capacity) {
+    size_t slotCount = roundUpToGroups(capacity);
+    ctrl_.assign(slotCount, CTRL_EMPTY);
+    slots_.resize(slotCount);
+    size_ = 0;
+    growthLeft_ = maxLoad(slotCount);
+}
+
+size_t FlatHashSet::findSlot(string_view key, size_t hashValue) const {
+    size_t groupMask = slots_.size() / GROUP_WIDTH - 1;
+    size_t group = h1(hashValue) & groupMask;
+    int8_t tag = h2(hashValue);
+
+    // Triangular probing over groups visits every group exactly once
+    // because the group count is a power of two.
+    for (size_t step = 1; step <= groupMask + 1; step++) {
+        const int8_t* ctrl = &ctrl_[group * GROUP_WIDTH];
+
+        uint32_t candidates = matchByte(ctrl, tag);
+        while (candidates != 0) {
+            size_t slot = group * GROUP_WIDTH + lowestBit(candidates);
+            if (slots_[slot] == key) {
+                return slot;
+            }
+            candidates &= candidates - 1;
+        }
+
+        if (matchByte(ctrl, CTRL_EMPTY) != 0) {
+            break;
+        }
+        group = (group + step) & groupMask;
+    }
+
+    return slots_.size();
+}
+
+size_t FlatHashSet::findInsertSlot(size_t hashValue) const {
+    size_t groupMask = slots_.size() / GROUP_WIDTH - 1;
+    size_t group = h1(hashValue) & groupMask;
+
+    for (size_t step = 1; ; step++) {
+        uint32_t free = matchEmptyOrDeleted(&ctrl_[group * GROUP_WIDTH]);
+        if (free != 0) {
+            return group * GROUP_WIDTH + lowestBit(free);
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+void FlatHashSet::rehash(size_t newCapacity) {
+    vector<int8_t> oldCtrl;
+    vector<string> oldSlots;
+    oldCtrl.swap(ctrl_);
+    oldSlots.swap(slots_);
+
+    ctrl_.assign(newCapacity, CTRL_EMPTY);
+    slots_.resize(newCapacity);
+    growthLeft_ = maxLoad(newCapacity) - size_;
+
+    hash<string_view> hasher;
+    for (size_t i = 0; i < oldSlots.size(); i++) {
+        if (oldCtrl[i] < 0) {
+            continue;
+        }
+        size_t hashValue = hasher(oldSlots[i]);
+        size_t slot = findInsertSlot(hashValue);
+        ctrl_[slot] = h2(hashValue);
+        slots_[slot] = std::move(oldSlots[i]);
+    }
+}
+
+void FlatHashSet::reserve(size_t n) {
+    size_t newCapacity = slots_.size();
+    while (maxLoad(newCapacity) < n) {
+        newCapacity *= 2;
+    }
+
+    if (newCapacity != slots_.size()) {
+        rehash(newCapacity);
+    }
+}
+
+bool FlatHashSet::insert(string_view key) {
+    hash<string_view> hasher;
+    size_t hashValue = hasher(key);
+
+    if (findSlot(key, hashValue) != slots_.size()) {
+        return false;
+    }
+
+    size_t slot = findInsertSlot(hashValue);
+    if (growthLeft_ == 0 && ctrl_[slot] == CTRL_EMPTY) {
+        // Out of empty slots: double when genuinely full, otherwise
+        // rebuild in place to flush accumulated tombstones.
+        if (size_ * 2 >= maxLoad(slots_.size())) {
+            rehash(slots_.size() * 2);
+        } else {
+            rehash(slots_.size());
+        }
+        slot = findInsertSlot(hashValue);
+    }
+
+    if (ctrl_[slot] == CTRL_EMPTY) {
+        growthLeft_ -= 1;
+    }
+    ctrl_[slot] = h2(hashValue);
+    slots_[slot] = key;
+    size_ += 1;
+    return true;
+}
+
+bool FlatHashSet::contains(string_view key) const {
+    hash<string_view> hasher;
+    return findSlot(key, hasher(key)) != slots_.size();
+}
+
+bool FlatHashSet::erase(string_view key) {
+    hash<string_view> hasher;
+    size_t slot = findSlot(key, hasher(key));
+    if (slot == slots_.size()) {
+        return false;
+    }
+
+    // A group that still has an empty slot never caused a probe to move
+    // past it, so the erased slot can go straight back to empty.
+    const int8_t* group = &ctrl_[slot / GROUP_WIDTH * GROUP_WIDTH];
+    if (matchByte(group, CTRL_EMPTY) != 0) {
+        ctrl_[slot] = CTRL_EMPTY;
+        growthLeft_ += 1;
+    } else {
+        ctrl_[slot] = CTRL_DELETED;
+    }
+
+    slots_[slot].clear();
+    slots_[slot].shrink_to_fit();
+    size_ -= 1;
+    return true;
+}
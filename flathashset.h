@@ -0,0 +1,51 @@
+#ifndef FLATHASHSET_H
+#define FLATHASHSET_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+// Open-addressing hash set in the Swiss-table style. Every slot has one
+// control byte (empty, deleted, or the low 7 bits of the key's hash) and
+// slots are probed 16 at a time, so a lookup usually touches one control
+// group and one slot instead of a bucket vector plus each chained string.
+class FlatHashSet {
+    public:
+    explicit FlatHashSet(size_t capacity = 16);
+
+    bool insert(string_view key);
+    bool contains(string_view key) const;
+    bool erase(string_view key);
+
+    // Make room for n keys without exceeding the 7/8 maximum load.
+    void reserve(size_t n);
+
+    size_t size() const {
+        return size_;
+    }
+
+    size_t capacity() const {
+        return slots_.size();
+    }
+
+    static const size_t GROUP_WIDTH = 16;
+
+    private:
+    vector<int8_t> ctrl_;
+    vector<string> slots_;
+    size_t size_;
+    size_t growthLeft_;
+
+    size_t findSlot(string_view key, size_t hashValue) const;
+    size_t findInsertSlot(size_t hashValue) const;
+    void rehash(size_t newCapacity);
+};
+
+#endif
@@ -0,0 +1,211 @@
+#include "frozendictionary.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+// 60% of the keys go to the first 30% of buckets. Those big buckets are
+// placed first while the table is still empty, which keeps pilots small.
+const uint64_t DENSE_SPLIT = 2576980377ULL;  // 0.6 * 2^32
+
+const unsigned MAX_ATTEMPTS = 16;
+
+// High 32 bits of value scaled into [0, range) without a division.
+inline size_t fastRange(uint64_t value, size_t range) {
+    return (size_t)(((value >> 32) * (uint64_t)range) >> 32);
+}
+
+}
+
+FrozenDictionary::FrozenDictionary(const vector<string_view>& words) {
+    vector<string_view> keys(words.begin(), words.end());
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+
+    vector<size_t> slots;
+    for (attempts_ = 1; attempts_ <= MAX_ATTEMPTS; attempts_++) {
+        seed_ = hashdetail::mix(attempts_, 0x9E3779B97F4A7C15ULL);
+        if (tryBuild(keys, slots)) {
+            break;
+        }
+    }
+    if (attempts_ > MAX_ATTEMPTS) {
+        throw runtime_error("FrozenDictionary: could not find pilots for every bucket");
+    }
+
+    // Lay the keys out in slot order.
+    vector<uint32_t> keyAtSlot(keyCount_);
+    size_t totalBytes = 0;
+    for (size_t k = 0; k < keyCount_; k++) {
+        keyAtSlot[slots[k]] = (uint32_t)k;
+        totalBytes += keys[k].size();
+    }
+
+    offsets_.resize(keyCount_ + 1);
+    arena_.resize(totalBytes);
+    size_t offset = 0;
+    for (size_t slot = 0; slot < keyCount_; slot++) {
+        string_view key = keys[keyAtSlot[slot]];
+        offsets_[slot] = (uint32_t)offset;
+        memcpy(arena_.data() + offset, key.data(), key.size());
+        offset += key.size();
+    }
+    offsets_[keyCount_] = (uint32_t)offset;
+}
+
+uint64_t FrozenDictionary::hashKey(string_view key) const {
+    WyHash hasher;
+    return hashdetail::mix(hasher(key.data(), key.size()) ^ seed_, 0xe7037ed1a0b428dbULL);
+}
+
+size_t FrozenDictionary::bucketOf(uint64_t hashValue) const {
+    uint32_t low = (uint32_t)hashValue;
+    // Scramble the selector bits so each side spreads over its buckets.
+    uint64_t spread = (uint64_t)(uint32_t)(low * 0x9E3779B1u) << 32;
+    if (low < DENSE_SPLIT) {
+        return fastRange(spread, denseBuckets_);
+    }
+    return denseBuckets_ + fastRange(spread, bucketCount_ - denseBuckets_);
+}
+
+size_t FrozenDictionary::positionOf(uint64_t hashValue, uint16_t pilot) const {
+    uint64_t pilotHash = hashdetail::mix(pilot ^ seed_, 0x8ebc6af09c88c6e3ULL);
+    return fastRange(hashValue ^ pilotHash, tableSize_);
+}
+
+bool FrozenDictionary::tryBuild(const vector<string_view>& keys, vector<size_t>& slots) {
+    keyCount_ = keys.size();
+    // A little slack (3%) keeps the last pilots cheap to find; slots past
+    // keyCount_ are remapped onto the holes below it afterwards.
+    tableSize_ = max<size_t>(keyCount_ + keyCount_ / 32, 1);
+    double log2Keys = log2((double)keyCount_ + 2);
+    bucketCount_ = max<size_t>((size_t)ceil(6.0 * keyCount_ / log2Keys), 2);
+    denseBuckets_ = max<size_t>(bucketCount_ * 3 / 10, 1);
+
+    vector<uint64_t> hashes(keyCount_);
+    vector<uint32_t> bucketStart(bucketCount_ + 1, 0);
+    for (size_t k = 0; k < keyCount_; k++) {
+        hashes[k] = hashKey(keys[k]);
+        bucketStart[bucketOf(hashes[k]) + 1]++;
+    }
+
+    // Counting sort of keys by bucket, then of buckets by size (largest first).
+    size_t largestBucket = 0;
+    for (size_t b = 0; b < bucketCount_; b++) {
+        largestBucket = max<size_t>(largestBucket, bucketStart[b + 1]);
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    vector<uint32_t> keysByBucket(keyCount_);
+    vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (size_t k = 0; k < keyCount_; k++) {
+        keysByBucket[fill[bucketOf(hashes[k])]++] = (uint32_t)k;
+    }
+
+    vector<vector<uint32_t>> bucketsBySize(largestBucket + 1);
+    for (size_t b = 0; b < bucketCount_; b++) {
+        bucketsBySize[bucketStart[b + 1] - bucketStart[b]].push_back((uint32_t)b);
+    }
+
+    pilots_.assign(bucketCount_, 0);
+    slots.assign(keyCount_, 0);
+    vector<bool> taken(tableSize_, false);
+    vector<size_t> positions;
+
+    for (size_t bucketSize = largestBucket; bucketSize > 0; bucketSize--) {
+        for (uint32_t bucket : bucketsBySize[bucketSize]) {
+            const uint32_t* members = &keysByBucket[bucketStart[bucket]];
+            bool placed = false;
+
+            for (uint32_t pilot = 0; pilot <= 0xFFFF && !placed; pilot++) {
+                positions.clear();
+                bool fits = true;
+                for (size_t i = 0; i < bucketSize && fits; i++) {
+                    size_t position = positionOf(hashes[members[i]], (uint16_t)pilot);
+                    if (taken[position]) {
+                        fits = false;
+                    } else {
+                        taken[position] = true;
+                        positions.push_back(position);
+                    }
+                }
+
+                if (!fits) {
+                    for (size_t position : positions) {
+                        taken[position] = false;
+                    }
+                    continue;
+                }
+
+                pilots_[bucket] = (uint16_t)pilot;
+                for (size_t i = 0; i < bucketSize; i++) {
+                    slots[members[i]] = positions[i];
+                }
+                placed = true;
+            }
+
+            if (!placed) {
+                return false;
+            }
+        }
+    }
+
+    // Point every used slot past the end at one of the free slots below it.
+    remap_.assign(tableSize_ - keyCount_, 0);
+    size_t freeSlot = 0;
+    for (size_t position = keyCount_; position < tableSize_; position++) {
+        if (!taken[position]) {
+            continue;
+        }
+        while (taken[freeSlot]) {
+            freeSlot++;
+        }
+        remap_[position - keyCount_] = (uint32_t)freeSlot;
+        freeSlot++;
+    }
+    for (size_t k = 0; k < keyCount_; k++) {
+        if (slots[k] >= keyCount_) {
+            slots[k] = remap_[slots[k] - keyCount_];
+        }
+    }
+
+    return true;
+}
+
+size_t FrozenDictionary::slotOf(string_view key) const {
+    uint64_t hashValue = hashKey(key);
+    size_t position = positionOf(hashValue, pilots_[bucketOf(hashValue)]);
+    if (position >= keyCount_) {
+        position = remap_[position - keyCount_];
+    }
+    return position;
+}
+
+bool FrozenDictionary::contains(string_view key) const {
+    if (keyCount_ == 0) {
+        return false;
+    }
+
+    size_t slot = slotOf(key);
+    size_t start = offsets_[slot];
+    size_t length = offsets_[slot + 1] - start;
+    return length == key.size() && memcmp(arena_.data() + start, key.data(), length) == 0;
+}
+
+double FrozenDictionary::bitsPerKey() const {
+    if (keyCount_ == 0) {
+        return 0;
+    }
+    size_t bits = pilots_.size() * 16 + remap_.size() * 32;
+    return (double)bits / keyCount_;
+}
+
+size_t FrozenDictionary::memoryBytes() const {
+    return pilots_.size() * sizeof(uint16_t)
+         + remap_.size() * sizeof(uint32_t)
+         + offsets_.size() * sizeof(uint32_t)
+         + arena_.size();
+}
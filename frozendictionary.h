@@ -0,0 +1,64 @@
+#ifndef FROZENDICTIONARY_H
+#define FROZENDICTIONARY_H
+
+#include "hashpolicies.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+// Read-only dictionary over a minimal perfect hash in the PTHash style.
+// Keys are hashed into buckets, and each bucket stores a 16-bit pilot that
+// sends all of its keys to distinct slots. Slot i of the key arena holds
+// the only key that can hash there, so a lookup is one hash, one probe
+// and one compare.
+class FrozenDictionary {
+    public:
+    // Builds over the distinct words (duplicates are dropped).
+    explicit FrozenDictionary(const vector<string_view>& words);
+
+    bool contains(string_view key) const;
+
+    size_t size() const {
+        return keyCount_;
+    }
+
+    // Bits per key spent on the perfect hash itself (pilots and remap
+    // table), not counting the stored keys.
+    double bitsPerKey() const;
+
+    // Total bytes held, including the key arena.
+    size_t memoryBytes() const;
+
+    // Number of seeds tried before every bucket found a pilot.
+    unsigned attempts() const {
+        return attempts_;
+    }
+
+    private:
+    size_t keyCount_;
+    size_t tableSize_;
+    size_t bucketCount_;
+    size_t denseBuckets_;
+    uint64_t seed_;
+    unsigned attempts_;
+
+    vector<uint16_t> pilots_;
+    vector<uint32_t> remap_;
+    vector<uint32_t> offsets_;
+    vector<char> arena_;
+
+    uint64_t hashKey(string_view key) const;
+    size_t bucketOf(uint64_t hashValue) const;
+    size_t positionOf(uint64_t hashValue, uint16_t pilot) const;
+    size_t slotOf(string_view key) const;
+    bool tryBuild(const vector<string_view>& keys, vector<size_t>& slots);
+};
+
+#endif
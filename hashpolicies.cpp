@@ -0,0 +1,85 @@
+#include "hashpolicies.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <nmmintrin.h>
+#define HASHPOLICIES_CRC32_TARGET 1
+#endif
+
+namespace hashdetail {
+
+namespace {
+
+// Table for the reflected Castagnoli polynomial, used when the CPU has no
+// CRC32 instruction. It produces the same values as the instruction.
+struct Crc32cTable {
+    uint32_t entries[256];
+
+    Crc32cTable() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : (crc >> 1);
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+uint32_t crc32cSoftware(const char* data, size_t length) {
+    static const Crc32cTable table;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc = table.entries[(crc ^ (unsigned char)data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+#ifdef HASHPOLICIES_CRC32_TARGET
+__attribute__((target("sse4.2")))
+uint32_t crc32cHardware(const char* data, size_t length) {
+    uint64_t crc = 0xFFFFFFFFu;
+    size_t i = 0;
+#if defined(__x86_64__)
+    for (; i + 8 <= length; i += 8) {
+        crc = _mm_crc32_u64(crc, read64(data + i));
+    }
+#endif
+    // 32-bit builds have no 8-byte step and take the whole key 4 bytes at
+    // a time; on x86-64 this runs at most once. Then at most one 2- and
+    // 1-byte step finish the tail.
+    uint32_t crc32 = (uint32_t)crc;
+    for (; i + 4 <= length; i += 4) {
+        crc32 = _mm_crc32_u32(crc32, (uint32_t)read32(data + i));
+    }
+    if (i + 2 <= length) {
+        uint16_t pair;
+        memcpy(&pair, data + i, sizeof(pair));
+        crc32 = _mm_crc32_u16(crc32, pair);
+        i += 2;
+    }
+    if (i < length) {
+        crc32 = _mm_crc32_u8(crc32, (unsigned char)data[i]);
+    }
+    return ~crc32;
+}
+
+bool detectHardwareCrc() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+
+const bool hasHardwareCrc = detectHardwareCrc();
+#endif
+
+}
+
+uint32_t crc32c(const char* data, size_t length) {
+#ifdef HASHPOLICIES_CRC32_TARGET
+    if (hasHardwareCrc) {
+        return crc32cHardware(data, length);
+    }
+#endif
+    return crc32cSoftware(data, length);
+}
+
+}
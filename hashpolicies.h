@@ -0,0 +1,215 @@
+#ifndef HASHPOLICIES_H
+#define HASHPOLICIES_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+using std::size_t;
+using std::string;
+
+// Hasher policies turn a key's bytes into a 64-bit hash. Reducer policies
+// map that hash onto a bucket index. BasicHashTable is templated on one of
+// each, and menu option 7 compares every combination on the loaded words.
+
+namespace hashdetail {
+
+// A 64-bit hash as a size_t. Where size_t is 32 bits the two halves are
+// folded together, so the high bits still reach the reducer.
+inline size_t toSize(uint64_t hashValue) {
+    return sizeof(size_t) >= sizeof(uint64_t) ? (size_t)hashValue : (size_t)(hashValue ^ (hashValue >> 32));
+}
+
+}
+
+// The standard library's string hash (murmur-based in libstdc++).
+struct StdHash {
+    static const char* name() {
+        return "std::hash";
+    }
+
+    size_t operator()(const char* data, size_t length) const {
+        return std::hash<std::string_view>()(std::string_view(data, length));
+    }
+};
+
+// 64-bit FNV-1a: one xor and one multiply per byte. Cheap for short words
+// but its low bits mix poorly without a finalizer.
+struct Fnv1aHash {
+    static const char* name() {
+        return "FNV-1a";
+    }
+
+    size_t operator()(const char* data, size_t length) const {
+        uint64_t hashValue = 14695981039346656037ULL;
+        for (size_t i = 0; i < length; i++) {
+            hashValue ^= (unsigned char)data[i];
+            hashValue *= 1099511628211ULL;
+        }
+        return hashdetail::toSize(hashValue);
+    }
+};
+
+namespace hashdetail {
+
+inline uint64_t read64(const char* p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t read32(const char* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Multiply two 64-bit values and fold the 128-bit product.
+inline uint64_t mix(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t)a * b;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high;
+    uint64_t low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    uint64_t aLow = (uint32_t)a, aHigh = a >> 32;
+    uint64_t bLow = (uint32_t)b, bHigh = b >> 32;
+    uint64_t lowLow = aLow * bLow, lowHigh = aLow * bHigh;
+    uint64_t highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+    uint64_t middle = (lowLow >> 32) + (uint32_t)lowHigh + (uint32_t)highLow;
+    uint64_t low = (middle << 32) | (uint32_t)lowLow;
+    uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+// CRC32-C over the key; uses the SSE4.2 instruction when the CPU has it.
+uint32_t crc32c(const char* data, size_t length);
+
+}
+
+// wyhash-style hash: words of up to 16 bytes are read with at most four
+// overlapping loads and finished with two 64x64->128 multiplies.
+struct WyHash {
+    static const char* name() {
+        return "wyhash";
+    }
+
+    size_t operator()(const char* data, size_t length) const {
+        const uint64_t secret0 = 0xa0761d6478bd642fULL;
+        const uint64_t secret1 = 0xe7037ed1a0b428dbULL;
+        const uint64_t secret2 = 0x8ebc6af09c88c6e3ULL;
+
+        uint64_t seed = secret0;
+        uint64_t a;
+        uint64_t b;
+
+        if (length <= 16) {
+            if (length >= 4) {
+                size_t shift = (length >> 3) << 2;
+                a = (hashdetail::read32(data) << 32) | hashdetail::read32(data + shift);
+                b = (hashdetail::read32(data + length - 4) << 32)
+                    | hashdetail::read32(data + length - 4 - shift);
+            } else if (length > 0) {
+                a = ((uint64_t)(unsigned char)data[0] << 16)
+                    | ((uint64_t)(unsigned char)data[length >> 1] << 8)
+                    | (unsigned char)data[length - 1];
+                b = 0;
+            } else {
+                a = 0;
+                b = 0;
+            }
+        } else {
+            size_t remaining = length;
+            const char* p = data;
+            while (remaining > 16) {
+                seed = hashdetail::mix(hashdetail::read64(p) ^ secret1,
+                                       hashdetail::read64(p + 8) ^ seed);
+                p += 16;
+                remaining -= 16;
+            }
+            a = hashdetail::read64(p + remaining - 16);
+            b = hashdetail::read64(p + remaining - 8);
+        }
+
+        return hashdetail::toSize(hashdetail::mix(secret1 ^ length,
+                                                  hashdetail::mix(a ^ secret1, b ^ seed ^ secret2)));
+    }
+};
+
+// Hardware CRC32-C. The 32-bit CRC is spread over the full word with one
+// multiply so that the high bits used by MultiplyShiftReduce are filled.
+struct Crc32Hash {
+    static const char* name() {
+        return "CRC32-C";
+    }
+
+    size_t operator()(const char* data, size_t length) const {
+        return hashdetail::toSize(hashdetail::crc32c(data, length) * 0x9E3779B97F4A7C15ULL);
+    }
+};
+
+// hash % bucketCount: works for any bucket count but costs an integer
+// division on every lookup.
+struct ModuloReduce {
+    static const char* name() {
+        return "modulo";
+    }
+
+    static size_t bucketCountFor(size_t requested) {
+        return requested == 0 ? 8 : requested;
+    }
+
+    size_t operator()(size_t hashValue, size_t bucketCount) const {
+        return hashValue % bucketCount;
+    }
+};
+
+// hash & (bucketCount - 1): bucket counts are rounded up to a power of
+// two, and only the low bits of the hash are used.
+struct MaskReduce {
+    static const char* name() {
+        return "mask";
+    }
+
+    static size_t bucketCountFor(size_t requested) {
+        size_t result = 8;
+        while (result < requested) {
+            result *= 2;
+        }
+        return result;
+    }
+
+    size_t operator()(size_t hashValue, size_t bucketCount) const {
+        return hashValue & (bucketCount - 1);
+    }
+};
+
+// Lemire's multiply-shift: (high 32 bits of hash * bucketCount) >> 32.
+// Any bucket count below 2^32 works, and only the high bits are used.
+// A 32-bit size_t is its own high 32 bits.
+struct MultiplyShiftReduce {
+    static const char* name() {
+        return "multiply-shift";
+    }
+
+    static size_t bucketCountFor(size_t requested) {
+        return requested == 0 ? 8 : requested;
+    }
+
+    size_t operator()(size_t hashValue, size_t bucketCount) const {
+        uint64_t high = sizeof(size_t) >= sizeof(uint64_t) ? (uint64_t)hashValue >> 32 : (uint64_t)hashValue;
+        return (size_t)((high * (uint64_t)bucketCount) >> 32);
+    }
+};
+
+#endif
@@ -1,70 +1,254 @@
 #include "hashtable.h"
-#include <functional>
 #include <utility>
 
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+#ifdef HASHTABLE_STATS
+#define HASHTABLE_COUNT(field) (counters_.field += 1)
+#else
+#define HASHTABLE_COUNT(field) ((void)0)
+#endif
+
 using namespace std;
 
-HashTable::HashTable(size_t bucketCount) {
-    if (bucketCount == 0) {
-        bucketCount = 8;
-    }
+static inline void prefetch(const void* address) {
+#if defined(__GNUC__)
+    __builtin_prefetch(address);
+#elif defined(_MSC_VER)
+    _mm_prefetch((const char*)address, _MM_HINT_T0);
+#endif
+}
 
-    buckets_.resize(bucketCount);
+template <typename Hasher, typename Reducer, typename Storage>
+BasicHashTable<Hasher, Reducer, Storage>::BasicHashTable(size_t bucketCount) {
+    buckets_.resize(Reducer::bucketCountFor(bucketCount));
+    migrateIndex_ = 0;
     size_ = 0;
+    maxLoadFactor_ = 1.0;
 }
 
-size_t HashTable::indexFor(const string& key) const {
-    hash<string> hasher;
-    size_t hashValue = hasher(key);
-    size_t index = hashValue % buckets_.size();
-    return index;
+template <typename Hasher, typename Reducer, typename Storage>
+void BasicHashTable<Hasher, Reducer, Storage>::setMaxLoadFactor(double maxLoadFactor) {
+    if (maxLoadFactor <= 0) {
+        return;
+    }
+    maxLoadFactor_ = maxLoadFactor;
 }
 
-bool HashTable::insert(const string& key) {
-    size_t index = indexFor(key);
-    vector<string>& chain = buckets_[index];
+template <typename Hasher, typename Reducer, typename Storage>
+void BasicHashTable<Hasher, Reducer, Storage>::reserve(size_t n) {
+    finishRehash();
 
-    for (size_t i = 0; i < chain.size(); i++) {
-        if (chain[i] == key) {
-            return false;
-        } 
+    size_t needed = (size_t)(n / maxLoadFactor_) + 1;
+    if (needed <= buckets_.size()) {
+        return;
+    }
+
+    size_t newBucketCount = buckets_.size();
+    while (newBucketCount < needed) {
+        newBucketCount *= 2;
+    }
+
+    startGrowth(newBucketCount);
+    finishRehash();
+}
+
+template <typename Hasher, typename Reducer, typename Storage>
+void BasicHashTable<Hasher, Reducer, Storage>::startGrowth(size_t newBucketCount) {
+    oldBuckets_.swap(buckets_);
+    buckets_.clear();
+    buckets_.resize(newBucketCount);
+    migrateIndex_ = 0;
+}
+
+template <typename Hasher, typename Reducer, typename Storage>
+void BasicHashTable<Hasher, Reducer, Storage>::migrateBuckets(size_t count) {
+    while (count > 0 && migrateIndex_ < oldBuckets_.size()) {
+        vector<Entry>& chain = oldBuckets_[migrateIndex_];
+
+        for (size_t i = 0; i < chain.size(); i++) {
+            size_t index = indexFor(storage_.entryHash(chain[i], hasher_), buckets_.size());
+            buckets_[index].push_back(std::move(chain[i]));
+        }
+
+        vector<Entry>().swap(chain);
+        migrateIndex_ += 1;
+        count -= 1;
     }
 
-    chain.push_back(key);
+    if (migrateIndex_ == oldBuckets_.size()) {
+        vector<vector<Entry>>().swap(oldBuckets_);
+        migrateIndex_ = 0;
+    }
+}
+
+template <typename Hasher, typename Reducer, typename Storage>
+void BasicHashTable<Hasher, Reducer, Storage>::finishRehash() {
+    if (isRehashing()) {
+        migrateBuckets(oldBuckets_.size());
+    }
+}
+
+template <typename Hasher, typename Reducer, typename Storage>
+bool BasicHashTable<Hasher, Reducer, Storage>::insert(string_view key) {
+    if (isRehashing()) {
+        migrateBuckets(MIGRATE_PER_INSERT);
+    }
+
+    size_t hashValue = hashOf(key);
+    if (containsHashed(key, hashValue)) {
+        return false;
+    }
+
+    size_t index = indexFor(hashValue, buckets_.size());
+    buckets_[index].push_back(storage_.makeEntry(key, hashValue));
     size_ += 1;
+
+    // Growth is spread over the following inserts. Doubling means the
+    // old array is always drained before the new one can fill up.
+    if (!isRehashing() && size_ > buckets_.size() * maxLoadFactor_) {
+        startGrowth(buckets_.size() * 2);
+    }
+
     return true;
 }
 
-bool HashTable::contains(const string& key) const {
-    size_t index = indexFor(key);
-    const vector<string>& chain = buckets_[index];
+template <typename Hasher, typename Reducer, typename Storage>
+bool BasicHashTable<Hasher, Reducer, Storage>::contains(string_view key) const {
+    return containsHashed(key, hashOf(key));
+}
+
+template <typename Hasher, typename Reducer, typename Storage>
+void BasicHashTable<Hasher, Reducer, Storage>::containsBatch(const string_view* keys, size_t count,
+                                                              bool* results) const {
+    size_t hashes[BATCH_GROUP];
+    size_t indexes[BATCH_GROUP];
+
+    for (size_t groupStart = 0; groupStart < count; groupStart += BATCH_GROUP) {
+        size_t groupSize = count - groupStart;
+        if (groupSize > BATCH_GROUP) {
+            groupSize = BATCH_GROUP;
+        }
+        const string_view* group = keys + groupStart;
+
+        // Stage 1: hash every key and prefetch its bucket header.
+        for (size_t i = 0; i < groupSize; i++) {
+            hashes[i] = hashOf(group[i]);
+            indexes[i] = indexFor(hashes[i], buckets_.size());
+            prefetch(&buckets_[indexes[i]]);
+        }
 
+        // Stage 2: the headers are arriving; prefetch the chain contents.
+        for (size_t i = 0; i < groupSize; i++) {
+            prefetch(buckets_[indexes[i]].data());
+        }
+
+        // Stage 3: compare keys. While rehashing this also checks the old
+        // bucket array, which was not prefetched.
+        for (size_t i = 0; i < groupSize; i++) {
+            results[groupStart + i] = containsHashed(group[i], hashes[i]);
+        }
+    }
+}
+
+template <typename Hasher, typename Reducer, typename Storage>
+bool BasicHashTable<Hasher, Reducer, Storage>::chainContains(const vector<Entry>& chain, string_view key,
+                                                              size_t hashValue) const {
     for (size_t i = 0; i < chain.size(); i++) {
-        if (chain[i] == key) {
+        HASHTABLE_COUNT(probes);
+        if (!storage_.hashMatches(chain[i], hashValue)) {
+            continue;
+        }
+
+        HASHTABLE_COUNT(keyCompares);
+        if (storage_.keyMatches(chain[i], key)) {
             return true;
         }
     }
-
     return false;
 }
 
-bool HashTable::erase(const string& key) {
-    size_t index = indexFor(key);
-    vector<string>& chain = buckets_[index];
+template <typename Hasher, typename Reducer, typename Storage>
+bool BasicHashTable<Hasher, Reducer, Storage>::containsHashed(string_view key, size_t hashValue) const {
+    HASHTABLE_COUNT(lookups);
+
+    bool found = chainContains(buckets_[indexFor(hashValue, buckets_.size())], key, hashValue);
+    if (!found && isRehashing()) {
+        found = chainContains(oldBuckets_[indexFor(hashValue, oldBuckets_.size())], key, hashValue);
+    }
+
+    if (found) {
+        HASHTABLE_COUNT(hits);
+    } else {
+        HASHTABLE_COUNT(misses);
+    }
+    return found;
+}
+
+template <typename Hasher, typename Reducer, typename Storage>
+vector<size_t> BasicHashTable<Hasher, Reducer, Storage>::chainLengthHistogram() const {
+    vector<size_t> histogram;
+    for (size_t i = 0; i < buckets_.size(); i++) {
+        if (buckets_[i].size() >= histogram.size()) {
+            histogram.resize(buckets_[i].size() + 1, 0);
+        }
+        histogram[buckets_[i].size()] += 1;
+    }
 
+    // Old buckets below migrateIndex_ are already drained.
+    for (size_t i = migrateIndex_; i < oldBuckets_.size(); i++) {
+        if (oldBuckets_[i].size() >= histogram.size()) {
+            histogram.resize(oldBuckets_[i].size() + 1, 0);
+        }
+        histogram[oldBuckets_[i].size()] += 1;
+    }
+    return histogram;
+}
+
+template <typename Hasher, typename Reducer, typename Storage>
+bool BasicHashTable<Hasher, Reducer, Storage>::eraseFromChain(vector<Entry>& chain, string_view key,
+                                                               size_t hashValue) {
     for (size_t i = 0; i < chain.size(); i++) {
-        if (chain[i] == key) {
+        if (storage_.matches(chain[i], key, hashValue)) {
+            storage_.release(chain[i]);
             if (i+1 != chain.size()) {
-                string temp = chain.back();
-                chain[i] = temp;
+                chain[i] = std::move(chain.back());
             }
 
             chain.pop_back();
-
-            size_ -= 1;
-
             return true;
         }
     }
     return false;
-}
\ No newline at end of file
+}
+
+template <typename Hasher, typename Reducer, typename Storage>
+bool BasicHashTable<Hasher, Reducer, Storage>::erase(string_view key) {
+    size_t hashValue = hashOf(key);
+    bool erased = eraseFromChain(buckets_[indexFor(hashValue, buckets_.size())], key, hashValue);
+
+    if (!erased && isRehashing()) {
+        erased = eraseFromChain(oldBuckets_[indexFor(hashValue, oldBuckets_.size())], key, hashValue);
+    }
+
+    if (erased) {
+        size_ -= 1;
+    }
+    return erased;
+}
+
+#define INSTANTIATE_HASHTABLES(Hasher, Storage) \
+    template class BasicHashTable<Hasher, ModuloReduce, Storage>; \
+    template class BasicHashTable<Hasher, MaskReduce, Storage>; \
+    template class BasicHashTable<Hasher, MultiplyShiftReduce, Storage>;
+
+INSTANTIATE_HASHTABLES(StdHash, StringStorage)
+INSTANTIATE_HASHTABLES(Fnv1aHash, StringStorage)
+INSTANTIATE_HASHTABLES(WyHash, StringStorage)
+INSTANTIATE_HASHTABLES(Crc32Hash, StringStorage)
+INSTANTIATE_HASHTABLES(StdHash, ArenaStorage)
+INSTANTIATE_HASHTABLES(Fnv1aHash, ArenaStorage)
+INSTANTIATE_HASHTABLES(WyHash, ArenaStorage)
+INSTANTIATE_HASHTABLES(Crc32Hash, ArenaStorage)
@@ -1,21 +1,55 @@
 #ifndef HASHTABLE_H
 #define HASHTABLE_H
 
+#include "hashpolicies.h"
+#include "keystorage.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstddef>
 
 using std::size_t;
 using std::string;
+using std::string_view;
 using std::vector;
 
-class HashTable {
+// Lookup counters, kept only when built with -DHASHTABLE_STATS (make stats).
+// Otherwise they compile away and always read zero.
+// Lookups include the duplicate check done by insert().
+struct HashTableCounters {
+    size_t lookups = 0;
+    size_t probes = 0;          // chain entries visited
+    size_t keyCompares = 0;     // full key comparisons
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+// Chained hash table. Hasher maps a key to a 64-bit hash and Reducer maps
+// that hash onto a bucket (see hashpolicies.h). Storage decides whether
+// chains hold whole strings or references into a key arena (see
+// keystorage.h). Every built-in combination is instantiated in
+// hashtable.cpp.
+template <typename Hasher, typename Reducer, typename Storage = StringStorage>
+class BasicHashTable {
     public:
-    explicit HashTable(size_t bucketCount = 32768);
+    explicit BasicHashTable(size_t bucketCount = 16);
+
+    bool insert(string_view key);
+    bool contains(string_view key) const;
+    bool erase(string_view key);
+
+    // Looks up count keys and writes one result per key. Keys are handled
+    // in groups: every key in a group is hashed and its bucket prefetched,
+    // then every chain is prefetched, and only then are keys compared, so
+    // the memory misses of a whole group overlap.
+    void containsBatch(const string_view* keys, size_t count, bool* results) const;
 
-    bool insert(const string& key);
-    bool contains(const string& key) const;
-    bool erase(const string& key);
+    // Keys per prefetch group in containsBatch().
+    static const size_t BATCH_GROUP = 16;
+
+    // Make room for n keys without exceeding the maximum load factor.
+    // Any growth still in progress is finished first.
+    void reserve(size_t n);
 
     size_t size() const {
         return size_;
@@ -25,10 +59,93 @@ class HashTable {
         return buckets_.size();
     }
 
+    double loadFactor() const {
+        return (double)size_ / buckets_.size();
+    }
+
+    double maxLoadFactor() const {
+        return maxLoadFactor_;
+    }
+
+    void setMaxLoadFactor(double maxLoadFactor);
+
+    static bool statsEnabled() {
+#ifdef HASHTABLE_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    HashTableCounters counters() const {
+#ifdef HASHTABLE_STATS
+        return counters_;
+#else
+        return HashTableCounters();
+#endif
+    }
+
+    void resetCounters() {
+#ifdef HASHTABLE_STATS
+        counters_ = HashTableCounters();
+#endif
+    }
+
+    // histogram[n] is the number of buckets holding n keys. Computed by a
+    // scan, so it costs nothing on lookups. Mid-rehash, the undrained old
+    // buckets are included.
+    vector<size_t> chainLengthHistogram() const;
+
+    // True while keys are still being moved out of the previous bucket
+    // array after a growth step.
+    bool isRehashing() const {
+        return !oldBuckets_.empty();
+    }
+
+    // Bytes held by the key arena (zero for string storage).
+    size_t arenaBytes() const {
+        return storage_.arenaBytes();
+    }
+
+    // Number of old buckets each insert moves across while rehashing.
+    static const size_t MIGRATE_PER_INSERT = 4;
+
+    typedef typename Storage::Entry Entry;
+
     private:
-    vector<vector<string>> buckets_;
+    vector<vector<Entry>> buckets_;
+    vector<vector<Entry>> oldBuckets_;
+    size_t migrateIndex_;
     size_t size_;
-    size_t indexFor(const string& key) const;
+    double maxLoadFactor_;
+    Hasher hasher_;
+    Reducer reducer_;
+    Storage storage_;
+#ifdef HASHTABLE_STATS
+    mutable HashTableCounters counters_;
+#endif
+
+    size_t hashOf(string_view key) const {
+        return hasher_(key.data(), key.size());
+    }
+
+    size_t indexFor(size_t hashValue, size_t bucketCount) const {
+        return reducer_(hashValue, bucketCount);
+    }
+
+    bool containsHashed(string_view key, size_t hashValue) const;
+    bool chainContains(const vector<Entry>& chain, string_view key, size_t hashValue) const;
+    bool eraseFromChain(vector<Entry>& chain, string_view key, size_t hashValue);
+    void startGrowth(size_t newBucketCount);
+    void migrateBuckets(size_t count);
+    void finishRehash();
 };
 
-#endif
\ No newline at end of file
+// The table the rest of the program uses: wyhash with power-of-two masking
+// replaces std::hash with modulo, which paid a division on every lookup.
+typedef BasicHashTable<WyHash, MaskReduce> HashTable;
+
+// Same table with every key's bytes packed into one arena.
+typedef BasicHashTable<WyHash, MaskReduce, ArenaStorage> ArenaHashTable;
+
+#endif
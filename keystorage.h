@@ -0,0 +1,124 @@
+#ifndef KEYSTORAGE_H
+#define KEYSTORAGE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+// Storage policies decide what BasicHashTable keeps in its bucket chains.
+// Each one defines an Entry type plus how to build, compare and rehash it.
+// hashMatches() is the cheap pre-check; keyMatches() is the full compare.
+
+// Every key is its own std::string. Words past the small-string limit
+// each cost a separate heap allocation.
+struct StringStorage {
+    typedef string Entry;
+
+    static const char* name() {
+        return "std::string";
+    }
+
+    Entry makeEntry(string_view key, size_t) {
+        return Entry(key);
+    }
+
+    bool hashMatches(const Entry&, size_t) const {
+        return true;
+    }
+
+    bool keyMatches(const Entry& entry, string_view key) const {
+        return entry == key;
+    }
+
+    bool matches(const Entry& entry, string_view key, size_t hashValue) const {
+        return hashMatches(entry, hashValue) && keyMatches(entry, key);
+    }
+
+    template <typename Hasher>
+    size_t entryHash(const Entry& entry, const Hasher& hasher) const {
+        return hasher(entry.data(), entry.size());
+    }
+
+    void release(const Entry&) {
+    }
+
+    size_t arenaBytes() const {
+        return 0;
+    }
+};
+
+// Key bytes are appended to one growable char arena, and chains hold only
+// {offset, length, cached hash}. Lookups compare the cached hash before
+// touching any key bytes, and growth never needs to rehash a key.
+// Erased keys leave their bytes behind in the arena. Offsets and lengths
+// are 32-bit, so the arena holds at most 4 GiB of key bytes.
+class ArenaStorage {
+    public:
+    struct Entry {
+        uint64_t hash;
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    static const char* name() {
+        return "arena";
+    }
+
+    // Throws std::length_error once the key would not fit in the arena.
+    Entry makeEntry(string_view key, size_t hashValue) {
+        if (key.size() > UINT32_MAX - bytes_.size()) {
+            throw std::length_error("ArenaStorage: key arena past 4 GiB");
+        }
+        Entry entry;
+        entry.hash = hashValue;
+        entry.offset = (uint32_t)bytes_.size();
+        entry.length = (uint32_t)key.size();
+        bytes_.insert(bytes_.end(), key.begin(), key.end());
+        return entry;
+    }
+
+    bool hashMatches(const Entry& entry, size_t hashValue) const {
+        return entry.hash == hashValue;
+    }
+
+    bool keyMatches(const Entry& entry, string_view key) const {
+        return entry.length == key.size()
+            && memcmp(bytes_.data() + entry.offset, key.data(), entry.length) == 0;
+    }
+
+    bool matches(const Entry& entry, string_view key, size_t hashValue) const {
+        return hashMatches(entry, hashValue) && keyMatches(entry, key);
+    }
+
+    template <typename Hasher>
+    size_t entryHash(const Entry& entry, const Hasher&) const {
+        return (size_t)entry.hash;
+    }
+
+    void release(const Entry& entry) {
+        deadBytes_ += entry.length;
+    }
+
+    size_t arenaBytes() const {
+        return bytes_.capacity();
+    }
+
+    size_t deadBytes() const {
+        return deadBytes_;
+    }
+
+    private:
+    vector<char> bytes_;
+    size_t deadBytes_ = 0;
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "loudstrie.h"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+inline unsigned popcount64(uint64_t bits) {
+#if defined(_MSC_VER)
+    return (unsigned)__popcnt64(bits);
+#else
+    return (unsigned)__builtin_popcountll(bits);
+#endif
+}
+
+// Index of the k-th set bit of bits, counting k from 1.
+inline unsigned selectInWord(uint64_t bits, size_t k) {
+    for (size_t i = 1; i < k; i++) {
+        bits &= bits - 1;
+    }
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctzll(bits);
+#endif
+}
+
+// A node still to be numbered: the sorted words [begin, end) all share
+// their first depth characters.
+struct PendingNode {
+    size_t begin;
+    size_t end;
+    size_t depth;
+};
+
+}
+
+void RankSelectBits::push(bool bit) {
+    if ((size_ & 63) == 0) {
+        words_.push_back(0);
+    }
+    if (bit) {
+        words_.back() |= 1ULL << (size_ & 63);
+    }
+    size_++;
+}
+
+void RankSelectBits::buildIndex() {
+    // Pad to whole blocks so every block has a full set of words.
+    size_t blocks = (words_.size() + WORDS_PER_BLOCK - 1) / WORDS_PER_BLOCK;
+    words_.resize(blocks * WORDS_PER_BLOCK, 0);
+    words_.shrink_to_fit();
+
+    blockRank_.assign(blocks + 1, 0);
+    zeroSamples_.clear();
+    size_t ones = 0;
+    size_t zeros = 0;
+    for (size_t block = 0; block < blocks; block++) {
+        blockRank_[block] = (uint32_t)ones;
+        for (size_t w = 0; w < WORDS_PER_BLOCK; w++) {
+            size_t word = block * WORDS_PER_BLOCK + w;
+            size_t validBits = min((size_t)64, size_ > word * 64 ? size_ - word * 64 : 0);
+            unsigned wordOnes = popcount64(words_[word]);
+            // Sample the block holding zeros number 1, SAMPLE + 1, 2 * SAMPLE + 1, ...
+            size_t wordZeros = validBits - wordOnes;
+            while (zeroSamples_.size() * SELECT_SAMPLE < zeros + wordZeros) {
+                zeroSamples_.push_back((uint32_t)block);
+            }
+            ones += wordOnes;
+            zeros += wordZeros;
+        }
+    }
+    blockRank_[blocks] = (uint32_t)ones;
+}
+
+size_t RankSelectBits::rank1(size_t position) const {
+    size_t block = position / BLOCK_BITS;
+    size_t rank = blockRank_[block];
+    size_t word = block * WORDS_PER_BLOCK;
+    for (; word < (position >> 6); word++) {
+        rank += popcount64(words_[word]);
+    }
+    if (position & 63) {
+        rank += popcount64(words_[word] & ((1ULL << (position & 63)) - 1));
+    }
+    return rank;
+}
+
+size_t RankSelectBits::select0(size_t k) const {
+    size_t block = zeroSamples_[(k - 1) / SELECT_SAMPLE];
+    size_t blocks = blockRank_.size() - 1;
+    while (block + 1 < blocks && zerosBefore(block + 1) < k) {
+        block++;
+    }
+
+    size_t remaining = k - zerosBefore(block);
+    size_t word = block * WORDS_PER_BLOCK;
+    while (true) {
+        uint64_t inverted = ~words_[word];
+        size_t zeros = popcount64(inverted);
+        if (remaining <= zeros) {
+            return word * 64 + selectInWord(inverted, remaining);
+        }
+        remaining -= zeros;
+        word++;
+    }
+}
+
+size_t RankSelectBits::memoryBytes() const {
+    return words_.capacity() * sizeof(uint64_t)
+         + blockRank_.capacity() * sizeof(uint32_t)
+         + zeroSamples_.capacity() * sizeof(uint32_t);
+}
+
+LoudsTrie::LoudsTrie(const vector<string_view>& words) {
+    vector<string_view> keys(words.begin(), words.end());
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    wordCount_ = keys.size();
+
+    // The super-root "10" makes the root the first 1-bit, so node i is
+    // always the i-th 1-bit and its child block follows the (i + 1)-th 0.
+    shape_.push(true);
+    shape_.push(false);
+
+    vector<bool> terminal;
+    vector<PendingNode> level(1, PendingNode{0, keys.size(), 0});
+    for (size_t next = 0; next < level.size(); next++) {
+        PendingNode node = level[next];
+
+        size_t first = node.begin;
+        bool endsHere = first < node.end && keys[first].size() == node.depth;
+        terminal.push_back(endsHere);
+        if (endsHere) {
+            first++;
+        }
+
+        size_t i = first;
+        while (i < node.end) {
+            char label = keys[i][node.depth];
+            size_t childEnd = i + 1;
+            while (childEnd < node.end && keys[childEnd][node.depth] == label) {
+                childEnd++;
+            }
+            shape_.push(true);
+            labels_.push_back(label);
+            level.push_back(PendingNode{i, childEnd, node.depth + 1});
+            i = childEnd;
+        }
+        shape_.push(false);
+    }
+    shape_.buildIndex();
+    labels_.shrink_to_fit();
+
+    terminal_.assign((terminal.size() + 63) / 64, 0);
+    for (size_t node = 0; node < terminal.size(); node++) {
+        if (terminal[node]) {
+            terminal_[node >> 6] |= 1ULL << (node & 63);
+        }
+    }
+}
+
+int64_t LoudsTrie::walk(string_view text) const {
+    size_t node = 0;
+    for (char c : text) {
+        // The child block starts after the (node + 1)-th zero, and every
+        // bit before it is either one of those zeros or a child of an
+        // earlier node, which gives the first child's number directly.
+        size_t position = shape_.select0(node + 1) + 1;
+        size_t child = position - node - 1;
+        while (shape_.get(position) && labels_[child - 1] != c) {
+            position++;
+            child++;
+        }
+        if (!shape_.get(position)) {
+            return -1;
+        }
+        node = child;
+    }
+    return (int64_t)node;
+}
+
+bool LoudsTrie::search(string_view word) const {
+    int64_t node = walk(word);
+    return node >= 0 && isTerminal((size_t)node);
+}
+
+bool LoudsTrie::startsWith(string_view prefix) const {
+    return walk(prefix) >= 0;
+}
+
+void LoudsTrie::collect(size_t node, string& prefix, vector<string>& out, size_t limit) const {
+    if (out.size() >= limit) {
+        return;
+    }
+    if (isTerminal(node)) {
+        out.push_back(prefix);
+    }
+    size_t position = shape_.select0(node + 1) + 1;
+    size_t child = position - node - 1;
+    for (; shape_.get(position) && out.size() < limit; position++, child++) {
+        prefix.push_back(labels_[child - 1]);
+        collect(child, prefix, out, limit);
+        prefix.pop_back();
+    }
+}
+
+vector<string> LoudsTrie::withPrefix(string_view prefix, size_t limit) const {
+    vector<string> out;
+    int64_t node = walk(prefix);
+    if (node >= 0) {
+        string buffer(prefix);
+        collect((size_t)node, buffer, out, limit);
+    }
+    return out;
+}
+
+size_t LoudsTrie::memoryBytes() const {
+    return shape_.memoryBytes() + labels_.capacity() + terminal_.capacity() * sizeof(uint64_t);
+}
+
+double LoudsTrie::shapeBitsPerNode() const {
+    return 8.0 * (shape_.memoryBytes() + terminal_.capacity() * sizeof(uint64_t)) / nodeCount();
+}
+
+double LoudsTrie::bitsPerNode() const {
+    return 8.0 * memoryBytes() / nodeCount();
+}
@@ -0,0 +1,106 @@
+#ifndef LOUDSTRIE_H
+#define LOUDSTRIE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+// Bit vector with constant-time rank and near-constant-time select, for
+// succinct structures. Ranks are stored once per 512-bit block, and the
+// block of every SELECT_SAMPLE-th zero is sampled.
+class RankSelectBits {
+    public:
+    RankSelectBits() : size_(0) {}
+
+    void push(bool bit);
+
+    // Builds the rank and select directories; call once after the last push.
+    void buildIndex();
+
+    bool get(size_t position) const {
+        return (words_[position >> 6] >> (position & 63)) & 1;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    // Ones in [0, position).
+    size_t rank1(size_t position) const;
+
+    // Position of the k-th zero, counting from 1.
+    size_t select0(size_t k) const;
+
+    size_t memoryBytes() const;
+
+    private:
+    static const size_t BLOCK_BITS = 512;
+    static const size_t WORDS_PER_BLOCK = BLOCK_BITS / 64;
+    static const size_t SELECT_SAMPLE = 256;
+
+    vector<uint64_t> words_;
+    size_t size_;
+    vector<uint32_t> blockRank_;
+    vector<uint32_t> zeroSamples_;
+
+    size_t zerosBefore(size_t block) const {
+        return block * BLOCK_BITS - blockRank_[block];
+    }
+};
+
+// Read-only trie in LOUDS form (level-order unary degree sequence). Nodes
+// are numbered breadth-first, and each node writes its child count in
+// unary: one 1 per child, then a 0. The children of node i are found from
+// the position of the (i + 1)-th zero, so the tree shape costs about two
+// bits per node plus the rank/select directories. Labels are kept one
+// byte per node, in the same order.
+class LoudsTrie {
+    public:
+    // Builds over the distinct words (duplicates are dropped).
+    explicit LoudsTrie(const vector<string_view>& words);
+
+    bool search(string_view word) const;
+    bool startsWith(string_view prefix) const;
+
+    // Words starting with prefix in sorted order, at most limit of them.
+    vector<string> withPrefix(string_view prefix, size_t limit = SIZE_MAX) const;
+
+    size_t size() const {
+        return wordCount_;
+    }
+
+    size_t nodeCount() const {
+        return labels_.size() + 1;
+    }
+
+    // Bytes held by the shape bits, labels and terminal flags.
+    size_t memoryBytes() const;
+
+    // Memory per node, in bits, without and with the one-byte labels.
+    double shapeBitsPerNode() const;
+    double bitsPerNode() const;
+
+    private:
+    RankSelectBits shape_;
+    vector<char> labels_;
+    vector<uint64_t> terminal_;
+    size_t wordCount_;
+
+    bool isTerminal(size_t node) const {
+        return (terminal_[node >> 6] >> (node & 63)) & 1;
+    }
+
+    // Returns the node reached by reading text from the root, or -1.
+    int64_t walk(string_view text) const;
+
+    void collect(size_t node, string& prefix, vector<string>& out, size_t limit) const;
+};
+
+#endif
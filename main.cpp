@@ -1,23 +1,170 @@
 #include "trie.h"
+#include "radixtrie.h"
+#include "dawg.h"
+#include "doublearraytrie.h"
+#include "loudstrie.h"
 #include "hashtable.h"
+#include "flathashset.h"
+#include "frozendictionary.h"
+#include "concurrenthashtable.h"
+#include "concurrenttrie.h"
+#include "bloomfilter.h"
+#include "wordlist.h"
+#include "processmemory.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <chrono>
 #include <random>
+#include <regex>
 #include <iomanip>
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
 
 using namespace std;
 using namespace chrono;
 
+// Every global heap allocation is counted so the benchmark can check that
+// the query paths allocate nothing. Live bytes are tracked as well, using
+// the allocator's real block sizes, so a structure's footprint can be
+// measured instead of estimated.
+//
+// The counters are split into cache-line shards, one picked per thread, so
+// that the multithreaded benchmarks do not all contend on one line. Reads
+// sum the shards. A block freed on another thread than the one that made
+// it lands in a different shard, but the wrapping unsigned sum is still
+// exact.
+class ShardedCounter {
+    public:
+    void add(size_t amount) {
+        shards_[shardIndex()].value.fetch_add(amount, memory_order_relaxed);
+    }
+
+    void subtract(size_t amount) {
+        shards_[shardIndex()].value.fetch_sub(amount, memory_order_relaxed);
+    }
+
+    size_t load() const {
+        size_t total = 0;
+        for (const Shard& shard : shards_) {
+            total += shard.value.load(memory_order_relaxed);
+        }
+        return total;
+    }
+
+    private:
+    static const size_t SHARDS = 64;
+
+    struct alignas(64) Shard {
+        atomic<size_t> value;
+    };
+
+    // Zero-initialized before any allocation can happen, with no
+    // constructor to run.
+    Shard shards_[SHARDS];
+
+    static size_t shardIndex() {
+        static atomic<size_t> nextShard;
+        thread_local size_t shard = nextShard.fetch_add(1, memory_order_relaxed) % SHARDS;
+        return shard;
+    }
+};
+
+static ShardedCounter heapAllocations;
+static ShardedCounter heapBytesInUse;
+
+static size_t heapBlockSize(void* memory) {
+#if defined(_WIN32)
+    return _msize(memory);
+#elif defined(__APPLE__)
+    return malloc_size(memory);
+#else
+    return malloc_usable_size(memory);
+#endif
+}
+
+void* operator new(size_t size) {
+    heapAllocations.add(1);
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (!memory) {
+        throw bad_alloc();
+    }
+    heapBytesInUse.add(heapBlockSize(memory));
+    return memory;
+}
+
+// Kept out of line: once inlined into callers, GCC pairs the free() with
+// a new-expression and reports -Wmismatched-new-delete.
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+static void releaseHeapBlock(void* memory) {
+    if (memory) {
+        heapBytesInUse.subtract(heapBlockSize(memory));
+    }
+    free(memory);
+}
+
+void operator delete(void* memory) noexcept {
+    releaseHeapBlock(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    operator delete(memory);
+}
+
+enum TrieEngine {
+    STANDARD_TRIE,
+    RADIX_TRIE,
+    DAWG_TRIE,
+    LOUDS_TRIE
+};
+
+enum HashEngine {
+    CHAINED_HASH,
+    FLAT_HASH,
+    ARENA_HASH
+};
+
 class BenchmarkSystem {
 private:
     Trie* trie;
+    RadixTrie* radixTrie;
+    Dawg* dawg;
+    LoudsTrie* loudsTrie;
+    DoubleArrayTrie* doubleArrayTrie;
     HashTable* hashTable;
-    vector<string> allWords;
+    FlatHashSet* flatHashSet;
+    ArenaHashTable* arenaHashTable;
+    FrozenDictionary* frozenDictionary;
+    BloomFilter* bloomFilter;
+    TrieEngine trieEngine;
+    HashEngine hashEngine;
+    // The loaded file, tokenized in place. allWords views its mapping and
+    // arena, so it lives as long as the words do.
+    WordList* dataset;
+    vector<string_view> allWords;
+    // Weight of each loaded word, from the file's frequency column (1 when
+    // the file has none). Parallel to allWords.
+    vector<uint32_t> allWeights;
+    // File the words were last loaded from, for the loader benchmark.
+    string datasetPath;
     bool trieBuilt;
     bool hashTableBuilt;
+    bool frozenBuilt;
 
     // Store results for CSV export
     long long trieBuildTime;
@@ -26,19 +173,135 @@ private:
     double hashAvgLookup;
     size_t trieMemory;
     size_t hashMemory;
-
-    size_t estimateTrieMemory() {
-        size_t nodeSize = sizeof(TrieNode);
-        size_t estimatedNodes = allWords.size() * 5;
-        return estimatedNodes * nodeSize;
-    }
+    size_t trieQueryAllocations;
+    size_t hashQueryAllocations;
+    long long frozenBuildTime;
+    double frozenAvgLookup;
+    size_t frozenMemory;
+    size_t frozenQueryAllocations;
+
+    // Chain shape and lookup counters; only the chained engines have them.
+    bool hashShapeKnown;
+    size_t hashMaxChain;
+    size_t hashEmptyBuckets;
+    double hashProbesPerLookup;
+    double hashComparesPerLookup;
 
     size_t estimateHashTableMemory() {
+        if (hashEngine == FLAT_HASH) {
+            // One control byte plus one inline string per slot
+            return flatHashSet->capacity() * (sizeof(string) + 1);
+        }
+        if (hashEngine == ARENA_HASH) {
+            size_t bucketOverhead = arenaHashTable->bucketCount() * sizeof(vector<ArenaHashTable::Entry>);
+            size_t entryOverhead = arenaHashTable->size() * sizeof(ArenaHashTable::Entry);
+            return bucketOverhead + entryOverhead + arenaHashTable->arenaBytes();
+        }
         size_t bucketOverhead = hashTable->bucketCount() * sizeof(vector<string>);
         size_t stringOverhead = hashTable->size() * 50;
         return bucketOverhead + stringOverhead;
     }
 
+    template <typename Table>
+    void recordChainStats(const Table& table) {
+        vector<size_t> histogram = table.chainLengthHistogram();
+        hashMaxChain = histogram.size() - 1;
+        hashEmptyBuckets = histogram[0];
+
+        HashTableCounters counters = table.counters();
+        hashProbesPerLookup = counters.lookups ? (double)counters.probes / counters.lookups : 0;
+        hashComparesPerLookup = counters.lookups ? (double)counters.keyCompares / counters.lookups : 0;
+        hashShapeKnown = true;
+    }
+
+    template <typename Table>
+    void displayChainStats(const Table& table) {
+        recordChainStats(table);
+        vector<size_t> histogram = table.chainLengthHistogram();
+
+        size_t usedBuckets = table.bucketCount() - hashEmptyBuckets;
+        cout << "  - Empty buckets: " << hashEmptyBuckets << " (" << fixed << setprecision(1)
+             << 100.0 * hashEmptyBuckets / table.bucketCount() << "%)" << endl;
+        cout << "  - Avg non-empty chain: " << fixed << setprecision(2)
+             << (usedBuckets ? (double)table.size() / usedBuckets : 0) << endl;
+        cout << "  - Max chain: " << hashMaxChain << endl;
+        cout << "  - Chain length histogram:" << endl;
+        for (size_t length = 0; length < histogram.size(); length++) {
+            if (histogram[length] > 0) {
+                cout << "      " << right << setw(3) << length << ": " << histogram[length] << left << endl;
+            }
+        }
+
+        if (!Table::statsEnabled()) {
+            cout << "  - Lookup counters: disabled (build with 'make stats')" << endl;
+            return;
+        }
+        HashTableCounters counters = table.counters();
+        cout << "  - Lookups counted: " << counters.lookups << " (" << counters.hits << " hits, "
+             << counters.misses << " misses)" << endl;
+        cout << "  - Probes per lookup: " << fixed << setprecision(3) << hashProbesPerLookup << endl;
+        cout << "  - Key compares per lookup: " << fixed << setprecision(3) << hashComparesPerLookup << endl;
+    }
+
+    const char* trieEngineName() const {
+        if (trieEngine == RADIX_TRIE) {
+            return "Radix";
+        }
+        if (trieEngine == DAWG_TRIE) {
+            return "DAWG";
+        }
+        if (trieEngine == LOUDS_TRIE) {
+            return "LOUDS";
+        }
+        return "Standard";
+    }
+
+    bool trieSearch(string_view word) const {
+        if (trieEngine == RADIX_TRIE) {
+            return radixTrie->search(word);
+        }
+        if (trieEngine == DAWG_TRIE) {
+            return dawg->search(word);
+        }
+        if (trieEngine == LOUDS_TRIE) {
+            return loudsTrie->search(word);
+        }
+        return trie->search(word);
+    }
+
+    size_t trieNodeCount() const {
+        if (trieEngine == RADIX_TRIE) {
+            return radixTrie->nodeCount();
+        }
+        if (trieEngine == DAWG_TRIE) {
+            return dawg->stateCount();
+        }
+        if (trieEngine == LOUDS_TRIE) {
+            return loudsTrie->nodeCount();
+        }
+        return trie->nodeCount();
+    }
+
+    const char* hashEngineName() const {
+        if (hashEngine == FLAT_HASH) {
+            return "Flat (Swiss)";
+        }
+        if (hashEngine == ARENA_HASH) {
+            return "Chained (arena keys)";
+        }
+        return "Chained";
+    }
+
+    bool hashContains(string_view word) const {
+        if (hashEngine == FLAT_HASH) {
+            return flatHashSet->contains(word);
+        }
+        if (hashEngine == ARENA_HASH) {
+            return arenaHashTable->contains(word);
+        }
+        return hashTable->contains(word);
+    }
+
     void exportResultsToCSV() {
         ofstream csvFile("benchmark_results.csv");
         if (!csvFile.is_open()) {
@@ -46,19 +309,339 @@ private:
             return;
         }
 
-        csvFile << "Metric,Trie,Hash Table" << endl;
-        csvFile << "Build Time (ms)," << trieBuildTime << "," << hashBuildTime << endl;
+        // The frozen dictionary column is only filled in once it is built
+        string frozenBuild = frozenBuilt ? to_string(frozenBuildTime) : "N/A";
+        string frozenMB = frozenBuilt ? to_string(frozenMemory / 1024 / 1024) : "N/A";
+        string frozenWords = frozenBuilt ? to_string(frozenDictionary->size()) : "N/A";
+
+        csvFile << "Metric,Trie,Hash Table,Frozen Dictionary" << endl;
+        csvFile << "Build Time (ms)," << trieBuildTime << "," << hashBuildTime << "," << frozenBuild << endl;
         csvFile << "Avg Lookup Time (microseconds)," << fixed << setprecision(3)
-                << trieAvgLookup << "," << hashAvgLookup << endl;
+                << trieAvgLookup << "," << hashAvgLookup << ",";
+        if (frozenBuilt) {
+            csvFile << frozenAvgLookup << endl;
+        } else {
+            csvFile << "N/A" << endl;
+        }
         csvFile << "Memory Usage (MB)," << (trieMemory / 1024 / 1024) << ","
-                << (hashMemory / 1024 / 1024) << endl;
-        csvFile << "Words Loaded," << allWords.size() << "," << allWords.size() << endl;
+                << (hashMemory / 1024 / 1024) << "," << frozenMB << endl;
+        csvFile << "Words Loaded," << allWords.size() << "," << allWords.size() << "," << frozenWords << endl;
+        csvFile << "Heap Allocations During Queries," << trieQueryAllocations << ","
+                << hashQueryAllocations << "," << (frozenBuilt ? to_string(frozenQueryAllocations) : "N/A") << endl;
+        if (frozenBuilt) {
+            csvFile << "Perfect Hash Bits per Key,N/A,N/A," << fixed << setprecision(2)
+                    << frozenDictionary->bitsPerKey() << endl;
+        }
+        if (hashShapeKnown) {
+            csvFile << "Hash Max Chain Length,N/A," << hashMaxChain << ",N/A" << endl;
+            csvFile << "Hash Empty Buckets,N/A," << hashEmptyBuckets << ",N/A" << endl;
+            if (HashTable::statsEnabled()) {
+                csvFile << "Hash Probes per Lookup,N/A," << fixed << setprecision(3)
+                        << hashProbesPerLookup << ",N/A" << endl;
+                csvFile << "Hash Key Compares per Lookup,N/A," << hashComparesPerLookup << ",N/A" << endl;
+            }
+        }
 
         csvFile.close();
         cout << endl << "Results exported to 'benchmark_results.csv'" << endl;
         cout << "You can open this file in Excel or Google Sheets to create graphs!" << endl;
     }
 
+    template <typename Hasher, typename Reducer>
+    void benchmarkHashPolicy(ofstream& csvFile) {
+        const int ROUNDS = 5;
+        Hasher hasher;
+        Reducer reducer;
+        size_t bucketCount = Reducer::bucketCountFor(allWords.size());
+
+        size_t checksum = 0;
+        auto start = high_resolution_clock::now();
+        for (int round = 0; round < ROUNDS; round++) {
+            for (string_view word : allWords) {
+                checksum += reducer(hasher(word.data(), word.size()), bucketCount);
+            }
+        }
+        auto end = high_resolution_clock::now();
+        double nsPerKey = duration_cast<nanoseconds>(end - start).count()
+                          / ((double)ROUNDS * allWords.size());
+        // Stored so the compiler cannot drop the timed loop.
+        volatile size_t sink = checksum;
+        (void)sink;
+
+        // Pearson's chi-square of bucket occupancy against a uniform spread.
+        // Divided by its degrees of freedom it should sit close to 1.0.
+        vector<size_t> occupancy(bucketCount, 0);
+        for (string_view word : allWords) {
+            occupancy[reducer(hasher(word.data(), word.size()), bucketCount)]++;
+        }
+        double expected = allWords.size() / (double)bucketCount;
+        double chiSquare = 0;
+        for (size_t count : occupancy) {
+            double diff = count - expected;
+            chiSquare += diff * diff / expected;
+        }
+        double normalized = chiSquare / (bucketCount - 1);
+
+        cout << left << setw(12) << Hasher::name() << setw(16) << Reducer::name()
+             << setw(10) << bucketCount
+             << setw(10) << fixed << setprecision(2) << nsPerKey
+             << setw(14) << fixed << setprecision(0) << chiSquare
+             << fixed << setprecision(3) << normalized << endl;
+
+        csvFile << Hasher::name() << "," << Reducer::name() << "," << bucketCount << ","
+                << fixed << setprecision(2) << nsPerKey << ","
+                << fixed << setprecision(0) << chiSquare << ","
+                << fixed << setprecision(3) << normalized << endl;
+    }
+
+    template <typename Hasher>
+    void benchmarkHasher(ofstream& csvFile) {
+        benchmarkHashPolicy<Hasher, ModuloReduce>(csvFile);
+        benchmarkHashPolicy<Hasher, MaskReduce>(csvFile);
+        benchmarkHashPolicy<Hasher, MultiplyShiftReduce>(csvFile);
+    }
+
+    template <typename Table>
+    void benchmarkBatchLookups(const Table& table) {
+        const size_t NUM_LOOKUPS = 1 << 20;
+        const size_t MAX_BATCH = 256;
+
+        random_device rd;
+        mt19937 gen(rd());
+        uniform_int_distribution<size_t> dis(0, allWords.size() - 1);
+
+        vector<string_view> queries;
+        queries.reserve(NUM_LOOKUPS);
+        for (size_t i = 0; i < NUM_LOOKUPS; i++) {
+            queries.emplace_back(allWords[dis(gen)]);
+        }
+
+        ofstream csvFile("batch_lookup_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Batch Size,ns/lookup,Million lookups/s,Speedup vs Single" << endl;
+
+        size_t found = 0;
+        size_t totalLookups = NUM_LOOKUPS;
+        auto start = high_resolution_clock::now();
+        for (string_view word : queries) {
+            if (table.contains(word)) found++;
+        }
+        auto end = high_resolution_clock::now();
+        double singleNs = duration_cast<nanoseconds>(end - start).count() / (double)NUM_LOOKUPS;
+
+        cout << endl << "BATCH LOOKUP BENCHMARK (" << NUM_LOOKUPS << " lookups, "
+             << hashEngineName() << " engine):" << endl;
+        cout << string(60, '-') << endl;
+        cout << left << setw(15) << "Batch size" << setw(15) << "ns/lookup"
+             << setw(15) << "M lookups/s" << "Speedup" << endl;
+        cout << string(60, '-') << endl;
+        cout << left << setw(15) << "single" << setw(15) << fixed << setprecision(2) << singleNs
+             << setw(15) << (1000.0 / singleNs) << "1.00x" << endl;
+        csvFile << "single," << fixed << setprecision(2) << singleNs << "," << (1000.0 / singleNs) << ",1.00" << endl;
+
+        bool results[MAX_BATCH];
+        for (size_t batch = 1; batch <= MAX_BATCH; batch *= 2) {
+            start = high_resolution_clock::now();
+            for (size_t i = 0; i < NUM_LOOKUPS; i += batch) {
+                size_t count = min(batch, NUM_LOOKUPS - i);
+                table.containsBatch(&queries[i], count, results);
+                for (size_t j = 0; j < count; j++) {
+                    if (results[j]) found++;
+                }
+            }
+            end = high_resolution_clock::now();
+            double batchNs = duration_cast<nanoseconds>(end - start).count() / (double)NUM_LOOKUPS;
+            totalLookups += NUM_LOOKUPS;
+
+            cout << left << setw(15) << batch << setw(15) << fixed << setprecision(2) << batchNs
+                 << setw(15) << (1000.0 / batchNs) << (singleNs / batchNs) << "x" << endl;
+            csvFile << batch << "," << fixed << setprecision(2) << batchNs << ","
+                    << (1000.0 / batchNs) << "," << (singleNs / batchNs) << endl;
+        }
+
+        cout << string(60, '-') << endl;
+        cout << "Words found: " << found << " of " << totalLookups << " lookups" << endl;
+
+        csvFile.close();
+        cout << endl << "Results exported to 'batch_lookup_results.csv'" << endl;
+    }
+
+    // Runs threadCount workers against table for opsPerThread operations
+    // each, readPercent of them lookups, and returns million ops/second.
+    // Writes insert and then erase thread-private keys so the table size
+    // stays flat.
+    double measureConcurrentThroughput(ConcurrentHashTable& table, unsigned threadCount,
+                                       size_t opsPerThread, unsigned readPercent) {
+        atomic<bool> go(false);
+        atomic<size_t> found(0);
+        vector<thread> workers;
+
+        for (unsigned t = 0; t < threadCount; t++) {
+            workers.push_back(thread([&, t]() {
+                mt19937 gen(1234 + t);
+                vector<string> privateKeys;
+                for (int i = 0; i < 64; i++) {
+                    privateKeys.push_back(string(allWords[gen() % allWords.size()]) + "#" + to_string(t));
+                }
+
+                size_t localFound = 0;
+                size_t writes = 0;
+                while (!go.load()) {
+                    this_thread::yield();
+                }
+
+                for (size_t op = 0; op < opsPerThread; op++) {
+                    uint32_t roll = gen();
+                    if (roll % 100 < readPercent) {
+                        if (table.contains(allWords[(roll >> 7) % allWords.size()])) localFound++;
+                    } else {
+                        const string& key = privateKeys[(writes / 2) % privateKeys.size()];
+                        if (writes % 2 == 0) {
+                            table.insert(key);
+                        } else {
+                            table.erase(key);
+                        }
+                        writes++;
+                    }
+                }
+                found.fetch_add(localFound);
+            }));
+        }
+
+        auto start = high_resolution_clock::now();
+        go.store(true);
+        for (thread& worker : workers) {
+            worker.join();
+        }
+        auto end = high_resolution_clock::now();
+
+        double seconds = duration_cast<nanoseconds>(end - start).count() / 1e9;
+        return (threadCount * (double)opsPerThread) / seconds / 1e6;
+    }
+
+    // Reader throughput on a ConcurrentTrie: readerCount threads each do
+    // opsPerThread lookups, optionally while one more thread keeps
+    // inserting and removing its own words. Returns reader Mops/s; the
+    // writer's update count is stored in writerOps.
+    double measureConcurrentTrieReads(ConcurrentTrie& concurrentTrie, unsigned readerCount,
+                                      size_t opsPerThread, bool withWriter, size_t& writerOps) {
+        atomic<bool> go(false);
+        atomic<unsigned> readersLeft(readerCount);
+        atomic<size_t> found(0);
+        vector<thread> workers;
+
+        for (unsigned t = 0; t < readerCount; t++) {
+            workers.push_back(thread([&, t]() {
+                mt19937 gen(1234 + t);
+                size_t localFound = 0;
+                while (!go.load()) {
+                    this_thread::yield();
+                }
+                for (size_t op = 0; op < opsPerThread; op++) {
+                    if (concurrentTrie.search(allWords[gen() % allWords.size()])) localFound++;
+                }
+                found.fetch_add(localFound);
+                readersLeft.fetch_sub(1);
+            }));
+        }
+
+        writerOps = 0;
+        thread writer;
+        if (withWriter) {
+            writer = thread([&]() {
+                mt19937 gen(99);
+                vector<string> privateKeys;
+                for (int i = 0; i < 64; i++) {
+                    privateKeys.push_back(string(allWords[gen() % allWords.size()]) + "#");
+                }
+                while (!go.load()) {
+                    this_thread::yield();
+                }
+                while (readersLeft.load() > 0) {
+                    const string& key = privateKeys[(writerOps / 2) % privateKeys.size()];
+                    if (writerOps % 2 == 0) {
+                        concurrentTrie.insert(key);
+                    } else {
+                        concurrentTrie.remove(key);
+                    }
+                    writerOps++;
+                }
+            });
+        }
+
+        auto start = high_resolution_clock::now();
+        go.store(true);
+        for (thread& worker : workers) {
+            worker.join();
+        }
+        auto end = high_resolution_clock::now();
+        if (writer.joinable()) {
+            writer.join();
+        }
+
+        double seconds = duration_cast<nanoseconds>(end - start).count() / 1e9;
+        writerOps = (size_t)(writerOps / seconds);
+        return (readerCount * (double)opsPerThread) / seconds / 1e6;
+    }
+
+    void runConcurrentTrieBenchmark() {
+        if (allWords.empty()) {
+            cout << "Error: No words loaded. Please load a dataset first." << endl;
+            return;
+        }
+
+        const size_t OPS_PER_THREAD = 500000;
+
+        auto start = high_resolution_clock::now();
+        ConcurrentTrie concurrentTrie(allWords);
+        auto end = high_resolution_clock::now();
+        cout << "Concurrent trie built in " << duration_cast<milliseconds>(end - start).count() << " ms ("
+             << concurrentTrie.size() << " words)" << endl;
+
+        // Leave one hardware thread for the writer.
+        unsigned hardwareThreads = max(1u, thread::hardware_concurrency());
+        unsigned maxReaders = max(1u, hardwareThreads - 1);
+        vector<unsigned> readerCounts;
+        for (unsigned count = 1; count < maxReaders; count *= 2) {
+            readerCounts.push_back(count);
+        }
+        readerCounts.push_back(maxReaders);
+
+        ofstream csvFile("concurrent_trie_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Readers,Read Mops/s (no writer),Read Mops/s (with writer),Ratio,Writer updates/s" << endl;
+
+        cout << endl << "CONCURRENT TRIE BENCHMARK (RCU snapshots, " << OPS_PER_THREAD << " lookups per reader):" << endl;
+        cout << string(70, '-') << endl;
+        cout << left << setw(10) << "Readers" << setw(16) << "No writer" << setw(16) << "With writer"
+             << setw(10) << "Ratio" << "Writer upd/s" << endl;
+        cout << string(70, '-') << endl;
+
+        for (unsigned readers : readerCounts) {
+            size_t writerRate;
+            double alone = measureConcurrentTrieReads(concurrentTrie, readers, OPS_PER_THREAD, false, writerRate);
+            double contended = measureConcurrentTrieReads(concurrentTrie, readers, OPS_PER_THREAD, true, writerRate);
+
+            cout << left << setw(10) << readers << setw(16) << fixed << setprecision(2) << alone
+                 << setw(16) << contended << setw(10) << (contended / alone) << writerRate << endl;
+            csvFile << readers << "," << fixed << setprecision(2) << alone << "," << contended << ","
+                    << (contended / alone) << "," << writerRate << endl;
+        }
+
+        cout << string(70, '-') << endl;
+        cout << "Words stored: " << concurrentTrie.size() << ", retired nodes awaiting reclamation: "
+             << concurrentTrie.pendingReclaim() << endl;
+
+        csvFile.close();
+        cout << endl << "Results exported to 'concurrent_trie_results.csv'" << endl;
+    }
+
     void createTextReport() {
         ofstream reportFile("performance_report.txt");
         if (!reportFile.is_open()) {
@@ -75,7 +658,9 @@ private:
 
         reportFile << "DATASET INFORMATION:" << endl;
         reportFile << "------------------------------------------------------------" << endl;
-        reportFile << "Total words loaded: " << allWords.size() << endl << endl;
+        reportFile << "Total words loaded: " << allWords.size() << endl;
+        reportFile << "Trie engine: " << trieEngineName() << endl;
+        reportFile << "Hash Table engine: " << hashEngineName() << endl << endl;
 
         reportFile << "BUILD PERFORMANCE:" << endl;
         reportFile << "------------------------------------------------------------" << endl;
@@ -116,6 +701,15 @@ private:
             reportFile << "Winner: Hash Table (" << fixed << setprecision(0) << savings << "% less memory)" << endl << endl;
         }
 
+        if (frozenBuilt) {
+            reportFile << "FROZEN DICTIONARY (minimal perfect hash):" << endl;
+            reportFile << "------------------------------------------------------------" << endl;
+            reportFile << "Build time:         " << frozenBuildTime << " ms" << endl;
+            reportFile << "Average lookup:     " << fixed << setprecision(3) << frozenAvgLookup << " μs per query" << endl;
+            reportFile << "Perfect hash size:  " << fixed << setprecision(2) << frozenDictionary->bitsPerKey() << " bits per key" << endl;
+            reportFile << "Total memory:       ~" << (frozenMemory / 1024) << " KB (including key arena)" << endl << endl;
+        }
+
         reportFile << "ANALYSIS & CONCLUSIONS:" << endl;
         reportFile << "------------------------------------------------------------" << endl;
         reportFile << "- Hash Tables typically provide faster average-case lookups (O(1))" << endl;
@@ -135,117 +729,644 @@ private:
     }
 
 public:
-    BenchmarkSystem() : trie(nullptr), hashTable(nullptr), trieBuilt(false),
-                        hashTableBuilt(false), trieBuildTime(0), hashBuildTime(0),
-                        trieAvgLookup(0), hashAvgLookup(0), trieMemory(0), hashMemory(0) {}
+    BenchmarkSystem() : trie(nullptr), radixTrie(nullptr), dawg(nullptr), loudsTrie(nullptr), doubleArrayTrie(nullptr), hashTable(nullptr), flatHashSet(nullptr),
+                        arenaHashTable(nullptr), frozenDictionary(nullptr), bloomFilter(nullptr),
+                        trieEngine(STANDARD_TRIE), hashEngine(CHAINED_HASH), dataset(nullptr),
+                        trieBuilt(false), hashTableBuilt(false), frozenBuilt(false),
+                        trieBuildTime(0), hashBuildTime(0),
+                        trieAvgLookup(0), hashAvgLookup(0), trieMemory(0), hashMemory(0),
+                        trieQueryAllocations(0), hashQueryAllocations(0), frozenBuildTime(0),
+                        frozenAvgLookup(0), frozenMemory(0), frozenQueryAllocations(0),
+                        hashShapeKnown(false), hashMaxChain(0), hashEmptyBuckets(0),
+                        hashProbesPerLookup(0), hashComparesPerLookup(0) {}
 
     ~BenchmarkSystem() {
         if (trie) delete trie;
+        if (radixTrie) delete radixTrie;
+        if (dawg) delete dawg;
+        if (loudsTrie) delete loudsTrie;
+        if (doubleArrayTrie) delete doubleArrayTrie;
         if (hashTable) delete hashTable;
+        if (flatHashSet) delete flatHashSet;
+        if (arenaHashTable) delete arenaHashTable;
+        if (frozenDictionary) delete frozenDictionary;
+        if (bloomFilter) delete bloomFilter;
+        if (dataset) delete dataset;
     }
 
-    bool loadWordsFromFile(const string& filename) {
+    // The original loader, kept as the baseline for option 24: reads the
+    // file a line at a time through a stream and builds every field and
+    // every cleaned word as its own string. Same rules as WordList.
+    static bool loadWordsWithStream(const string& filename, vector<string>& allWords,
+                                    vector<uint32_t>& allWeights, size_t& weightedLines) {
         ifstream file(filename);
         if (!file.is_open()) {
-            cout << "Error: Could not open file '" << filename << "'" << endl;
             return false;
         }
 
         allWords.clear();
-        string word;
-        while (file >> word) {
-            string cleanWord;
-            for (char c : word) {
-                if (isalpha(c)) {
-                    cleanWord += tolower(c);
+        allWeights.clear();
+        weightedLines = 0;
+        string line;
+        vector<string> fields;
+        while (getline(file, line)) {
+            fields.clear();
+            size_t position = 0;
+            while (position < line.size()) {
+                while (position < line.size() && isspace((unsigned char)line[position])) position++;
+                size_t fieldStart = position;
+                while (position < line.size() && !isspace((unsigned char)line[position])) position++;
+                if (position > fieldStart) {
+                    fields.push_back(line.substr(fieldStart, position - fieldStart));
                 }
             }
-            if (!cleanWord.empty()) {
-                allWords.push_back(cleanWord);
+
+            // A "word count" line carries a frequency column; any other
+            // line is a run of words of weight 1.
+            uint32_t weight = 1;
+            if (fields.size() == 2 && all_of(fields[1].begin(), fields[1].end(), ::isdigit)) {
+                weight = (uint32_t)min(strtoull(fields[1].c_str(), nullptr, 10), (unsigned long long)UINT32_MAX);
+                fields.pop_back();
+                weightedLines++;
+            }
+
+            for (const string& word : fields) {
+                string cleanWord;
+                for (char c : word) {
+                    if (isalpha(c)) {
+                        cleanWord += tolower(c);
+                    }
+                }
+                if (!cleanWord.empty()) {
+                    allWords.push_back(cleanWord);
+                    allWeights.push_back(weight);
+                }
             }
         }
         file.close();
+        return true;
+    }
+
+    // Maps the file and tokenizes it in place (see WordList), one byte range
+    // per hardware thread. The WordList is kept, and allWords, which every
+    // structure builds from, is its views, so no word is copied.
+    bool loadWordsFromFile(const string& filename) {
+        resetPeakResident();
+        auto start = high_resolution_clock::now();
+        try {
+            WordList* loaded = new WordList(filename, max(1u, thread::hardware_concurrency()));
+            if (dataset) delete dataset;
+            dataset = loaded;
+            const WordList& words = *dataset;
+            allWords = words.words();
+            allWeights = words.weights();
 
-        cout << "Successfully loaded " << allWords.size() << " words from " << filename << endl;
+            auto end = high_resolution_clock::now();
+            cout << "Successfully loaded " << allWords.size() << " words from " << filename << " in "
+                 << fixed << setprecision(1) << duration_cast<microseconds>(end - start).count() / 1000.0
+                 << " ms (peak RSS " << peakResidentBytes() / (1024.0 * 1024.0) << " MB)" << endl;
+            if (words.normalizedCount() > 0) {
+                cout << words.normalizedCount() << " words needed cleaning or lowercasing" << endl;
+            }
+            if (words.weightedLines() > 0) {
+                cout << "Frequency column found on " << words.weightedLines() << " lines" << endl;
+            }
+        } catch (const runtime_error&) {
+            cout << "Error: Could not open file '" << filename << "'" << endl;
+            return false;
+        }
+        datasetPath = filename;
+        dropDerivedStructures();
         return !allWords.empty();
     }
 
-    void buildTrie() {
-        if (allWords.empty()) {
+    // The frozen dictionary, the double-array snapshot and the Bloom filter
+    // only describe the dataset they were built from, and searches would
+    // keep consulting them, so a new dataset drops them.
+    void dropDerivedStructures() {
+        if (frozenDictionary) delete frozenDictionary;
+        frozenDictionary = nullptr;
+        frozenBuilt = false;
+        if (doubleArrayTrie) delete doubleArrayTrie;
+        doubleArrayTrie = nullptr;
+        if (bloomFilter) delete bloomFilter;
+        bloomFilter = nullptr;
+    }
+
+    // Loads the current dataset file three ways and reports the time, the
+    // heap each one holds afterwards, and how far it pushed the resident
+    // set: tokenizing into views of a memory mapping, the same plus the
+    // copy of every word into its own string (what option 0 avoids by
+    // keeping the WordList), and the stream loader.
+    void runLoaderBenchmark() {
+        if (datasetPath.empty()) {
             cout << "Error: No words loaded. Please load a dataset first." << endl;
             return;
         }
 
-        if (trie) delete trie;
-        trie = new Trie();
+        ofstream csvFile("loader_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Loader,Words,Time (ms),Heap (MB),Peak RSS Growth (MB),Peak RSS (MB)" << endl;
+
+        bool peakResets = resetPeakResident();
+        cout << endl << "DATASET LOADER BENCHMARK (" << datasetPath << "):" << endl;
+        cout << string(78, '-') << endl;
+        cout << left << setw(26) << "Loader" << setw(10) << "Words" << setw(10) << "Time ms" << setw(10) << "Heap MB"
+             << setw(14) << "Peak RSS +MB" << "Peak RSS MB" << endl;
+        cout << string(78, '-') << endl;
+
+        auto report = [&](const string& name, auto load) {
+#if defined(__GLIBC__)
+            // Hand the previous run's freed pages back to the OS, so this
+            // run's growth is not hidden by reuse.
+            malloc_trim(0);
+#endif
+            resetPeakResident();
+            size_t residentBefore = currentResidentBytes();
+            size_t heapBefore = heapBytesInUse.load();
+            auto start = high_resolution_clock::now();
+            size_t heapHeld = 0;
+            size_t count = load(heapBefore, heapHeld);
+            auto end = high_resolution_clock::now();
+            double millis = duration_cast<microseconds>(end - start).count() / 1000.0;
+            double heapMegabytes = heapHeld / (1024.0 * 1024.0);
+            size_t peak = peakResidentBytes();
+            double growthMegabytes = (peak > residentBefore ? peak - residentBefore : 0) / (1024.0 * 1024.0);
+            double peakMegabytes = peak / (1024.0 * 1024.0);
+
+            cout << left << setw(26) << name << setw(10) << count << setw(10) << fixed << setprecision(1) << millis
+                 << setw(10) << heapMegabytes << setw(14) << growthMegabytes << peakMegabytes << endl;
+            csvFile << name << "," << count << "," << fixed << setprecision(1) << millis << "," << heapMegabytes
+                    << "," << growthMegabytes << "," << peakMegabytes << endl;
+        };
+
+        report("mmap, views", [&](size_t heapBefore, size_t& heapHeld) {
+            WordList words(datasetPath);
+            heapHeld = heapBytesInUse.load() - heapBefore;
+            return words.words().size();
+        });
+        report("mmap, copied to strings", [&](size_t heapBefore, size_t& heapHeld) {
+            WordList words(datasetPath);
+            vector<string> copies(words.words().begin(), words.words().end());
+            heapHeld = heapBytesInUse.load() - heapBefore;
+            return copies.size();
+        });
+        report("ifstream + getline", [&](size_t heapBefore, size_t& heapHeld) {
+            vector<string> words;
+            vector<uint32_t> weights;
+            size_t weightedLines;
+            loadWordsWithStream(datasetPath, words, weights, weightedLines);
+            heapHeld = heapBytesInUse.load() - heapBefore;
+            return words.size();
+        });
+
+        cout << string(78, '-') << endl;
+        cout << "Heap MB is what each loader holds once done (mapped pages are not heap)." << endl;
+        if (!peakResets) {
+            cout << "This OS cannot reset the peak RSS, so each peak includes the runs before it." << endl;
+        }
+        csvFile.close();
+        cout << endl << "Results exported to 'loader_results.csv'" << endl;
+    }
 
-        cout << "Building Trie with " << allWords.size() << " words..." << endl;
+    // Tokenizes the current dataset file with 1, 2, 4, ... threads up to
+    // the hardware thread count, best of three runs each, and reports the
+    // throughput and speedup over one thread. Every run must produce the
+    // same words in the same order as the single-threaded one.
+    void runTokenizerBenchmark() {
+        if (datasetPath.empty()) {
+            cout << "Error: No words loaded. Please load a dataset first." << endl;
+            return;
+        }
 
-        auto start = high_resolution_clock::now();
-        for (const string& word : allWords) {
-            trie->insert(word);
+        const int RUNS = 3;
+        unsigned maxThreads = max(1u, thread::hardware_concurrency());
+        vector<unsigned> threadCounts;
+        for (unsigned count = 1; count < maxThreads; count *= 2) {
+            threadCounts.push_back(count);
         }
-        auto end = high_resolution_clock::now();
-        auto duration = duration_cast<milliseconds>(end - start);
+        threadCounts.push_back(maxThreads);
 
-        trieBuildTime = duration.count();
-        trieBuilt = true;
-        cout << "Trie built successfully in " << trieBuildTime << " ms" << endl;
+        ofstream csvFile("tokenizer_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Threads,Chunks,Words,Time (ms),Throughput (MB/s),Speedup,Matches Serial" << endl;
+
+        // The reference output, and a first pass that pulls the file into
+        // the page cache so the timed runs measure tokenizing, not disk.
+        WordList serial(datasetPath);
+        double fileMegabytes = serial.fileBytes() / (1024.0 * 1024.0);
+
+        cout << endl << "PARALLEL TOKENIZER (" << datasetPath << ", " << fixed << setprecision(1) << fileMegabytes
+             << " MB, best of " << RUNS << ", " << maxThreads << " hardware threads):" << endl;
+        cout << string(70, '-') << endl;
+        cout << left << setw(10) << "Threads" << setw(10) << "Chunks" << setw(12) << "Words" << setw(12) << "Time ms"
+             << setw(10) << "MB/s" << setw(10) << "Speedup" << "Same" << endl;
+        cout << string(70, '-') << endl;
+
+        double single = 0;
+        for (unsigned threads : threadCounts) {
+            double best = 0;
+            size_t chunks = 0;
+            size_t count = 0;
+            bool same = true;
+            for (int run = 0; run < RUNS; run++) {
+                auto start = high_resolution_clock::now();
+                WordList words(datasetPath, threads);
+                auto end = high_resolution_clock::now();
+                double millis = duration_cast<microseconds>(end - start).count() / 1000.0;
+                best = (run == 0) ? millis : min(best, millis);
+                chunks = words.chunkCount();
+                count = words.words().size();
+                same = same && words.words() == serial.words() && words.weights() == serial.weights();
+            }
+            if (threads == 1) {
+                single = best;
+            }
+            double throughput = best > 0 ? fileMegabytes / (best / 1000.0) : 0;
+            double speedup = best > 0 ? single / best : 0;
+
+            cout << left << setw(10) << threads << setw(10) << chunks << setw(12) << count << setw(12) << fixed
+                 << setprecision(1) << best << setw(10) << throughput << setw(10) << setprecision(2) << speedup
+                 << (same ? "yes" : "NO") << endl;
+            csvFile << threads << "," << chunks << "," << count << "," << fixed << setprecision(1) << best << ","
+                    << throughput << "," << setprecision(2) << speedup << "," << (same ? "yes" : "no") << endl;
+        }
+        cout << string(70, '-') << endl;
+        cout << "Chunks can be fewer than threads when the file has fewer lines than threads." << endl;
+        csvFile.close();
+        cout << endl << "Results exported to 'tokenizer_results.csv'" << endl;
     }
 
-    void buildHashTable() {
+    void buildTrie() {
         if (allWords.empty()) {
             cout << "Error: No words loaded. Please load a dataset first." << endl;
             return;
         }
 
-        if (hashTable) delete hashTable;
-        hashTable = new HashTable(32768);
+        int engineChoice;
+        cout << "Select engine (0 = Standard, 1 = Radix/path-compressed, 2 = DAWG/read-only, 3 = LOUDS/succinct): ";
+        cin >> engineChoice;
+        if (engineChoice == 1) {
+            trieEngine = RADIX_TRIE;
+        } else if (engineChoice == 2) {
+            trieEngine = DAWG_TRIE;
+        } else if (engineChoice == 3) {
+            trieEngine = LOUDS_TRIE;
+        } else {
+            trieEngine = STANDARD_TRIE;
+        }
+
+        unsigned buildThreads = 1;
+        if (trieEngine == STANDARD_TRIE) {
+            cout << "Build threads (1 = single thread, 0 = measure the speedup curve): ";
+            cin >> buildThreads;
+        }
 
-        cout << "Building Hash Table with " << allWords.size() << " words..." << endl;
+        if (trie || radixTrie || dawg || loudsTrie) {
+            // Slab-backed nodes are released a slab at a time, so dropping
+            // the previous tree is cheap even for large dictionaries.
+            auto freeStart = high_resolution_clock::now();
+            if (trie) delete trie;
+            if (radixTrie) delete radixTrie;
+            if (dawg) delete dawg;
+            if (loudsTrie) delete loudsTrie;
+            auto freeEnd = high_resolution_clock::now();
+            cout << "Previous Trie freed in "
+                 << duration_cast<microseconds>(freeEnd - freeStart).count() << " μs" << endl;
+        }
+        trie = nullptr;
+        radixTrie = nullptr;
+        dawg = nullptr;
+        loudsTrie = nullptr;
+
+        if (trieEngine == STANDARD_TRIE && buildThreads == 0) {
+            buildThreads = measureParallelBuild();
+        }
+        size_t bytesBefore = heapBytesInUse.load();
+
+        cout << "Building " << trieEngineName() << " Trie with " << allWords.size() << " words..." << endl;
 
         auto start = high_resolution_clock::now();
-        for (const string& word : allWords) {
-            hashTable->insert(word);
+        if (trieEngine == RADIX_TRIE) {
+            radixTrie = new RadixTrie();
+            for (string_view word : allWords) {
+                radixTrie->insert(word);
+            }
+        } else if (trieEngine == DAWG_TRIE) {
+            dawg = new Dawg(allWords);
+        } else if (trieEngine == LOUDS_TRIE) {
+            loudsTrie = new LoudsTrie(allWords);
+        } else {
+            trie = new Trie();
+            if (buildThreads > 1) {
+                trie->buildParallel(allWords, allWeights, buildThreads);
+            } else {
+                for (size_t i = 0; i < allWords.size(); i++) {
+                    trie->insert(allWords[i], allWeights[i]);
+                }
+            }
         }
         auto end = high_resolution_clock::now();
         auto duration = duration_cast<milliseconds>(end - start);
 
-        hashBuildTime = duration.count();
-        hashTableBuilt = true;
-        cout << "Hash Table built successfully in " << hashBuildTime << " ms" << endl;
+        trieBuildTime = duration.count();
+        trieMemory = heapBytesInUse.load() - bytesBefore;
+        trieBuilt = true;
+        cout << "Trie built successfully in " << trieBuildTime << " ms (" << trieNodeCount() << " nodes";
+        if (buildThreads > 1) {
+            cout << ", " << buildThreads << " threads";
+        }
+        cout << ")" << endl;
     }
 
-    void searchWord() {
-        if (!trieBuilt && !hashTableBuilt) {
-            cout << "Error: Please build at least one data structure first." << endl;
+    // Standard Trie build time with repeated insert() against
+    // bulkLoadSorted(), on the words as loaded, on a sorted copy, and on a
+    // shuffled copy. bulkLoadSorted() has to sort unsorted input first.
+    // Best of three runs each.
+    void runBulkLoadBenchmark() {
+        if (allWords.empty()) {
+            cout << "Error: No words loaded. Please load a dataset first." << endl;
             return;
         }
 
-        string word;
-        cout << "Enter word to search: ";
-        cin >> word;
-        transform(word.begin(), word.end(), word.begin(), ::tolower);
-
-        if (trieBuilt) {
-            auto start = high_resolution_clock::now();
-            bool found = trie->search(word);
-            auto end = high_resolution_clock::now();
-            auto duration = duration_cast<nanoseconds>(end - start);
+        const int RUNS = 3;
 
-            cout << "Trie: '" << word << "' " << (found ? "FOUND" : "NOT FOUND")
-                 << " (Time: " << duration.count() << " ns)" << endl;
+        vector<size_t> order(allWords.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
         }
+        auto reordered = [&](vector<string_view>& words, vector<uint32_t>& weights) {
+            for (size_t i : order) {
+                words.emplace_back(allWords[i]);
+                weights.push_back(allWeights[i]);
+            }
+        };
+        stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return allWords[a] < allWords[b]; });
+        vector<string_view> sortedWords;
+        vector<uint32_t> sortedWeights;
+        reordered(sortedWords, sortedWeights);
+        shuffle(order.begin(), order.end(), mt19937(42));
+        vector<string_view> shuffledWords;
+        vector<uint32_t> shuffledWeights;
+        reordered(shuffledWords, shuffledWeights);
+
+        auto timeBuild = [&](const vector<string_view>& words, const vector<uint32_t>& weights, bool bulk) {
+            double best = 0;
+            for (int run = 0; run < RUNS; run++) {
+                auto start = high_resolution_clock::now();
+                Trie* candidate = new Trie();
+                if (bulk) {
+                    candidate->bulkLoadSorted(words, weights);
+                } else {
+                    for (size_t i = 0; i < words.size(); i++) {
+                        candidate->insert(words[i], weights[i]);
+                    }
+                }
+                auto end = high_resolution_clock::now();
+                delete candidate;
+                double millis = duration_cast<microseconds>(end - start).count() / 1000.0;
+                best = (run == 0) ? millis : min(best, millis);
+            }
+            return best;
+        };
 
-        if (hashTableBuilt) {
-            auto start = high_resolution_clock::now();
-            bool found = hashTable->contains(word);
-            auto end = high_resolution_clock::now();
-            auto duration = duration_cast<nanoseconds>(end - start);
+        bool loadedSorted = is_sorted(allWords.begin(), allWords.end());
+        string loadedLabel = loadedSorted ? "as loaded (sorted)" : "as loaded (unsorted)";
 
-            cout << "Hash Table: '" << word << "' " << (found ? "FOUND" : "NOT FOUND")
-                 << " (Time: " << duration.count() << " ns)" << endl;
-        }
+        ofstream csvFile("bulk_load_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Input,Insert Loop (ms),Bulk Load (ms),Speedup" << endl;
+
+        cout << endl << "TRIE BULK LOAD BENCHMARK (" << allWords.size() << " words, best of " << RUNS << "):" << endl;
+        cout << string(66, '-') << endl;
+        cout << left << setw(24) << "Input" << setw(16) << "Insert ms" << setw(16) << "Bulk load ms" << "Speedup" << endl;
+        cout << string(66, '-') << endl;
+
+        struct Input {
+            string label;
+            const vector<string_view>* words;
+            const vector<uint32_t>* weights;
+        };
+        vector<Input> inputs = {
+            {loadedLabel, &allWords, &allWeights},
+            {"sorted", &sortedWords, &sortedWeights},
+            {"shuffled", &shuffledWords, &shuffledWeights},
+        };
+        for (const Input& input : inputs) {
+            double inserted = timeBuild(*input.words, *input.weights, false);
+            double bulk = timeBuild(*input.words, *input.weights, true);
+            cout << left << setw(24) << input.label << setw(16) << fixed << setprecision(1) << inserted
+                 << setw(16) << bulk << setprecision(2) << inserted / bulk << endl;
+            csvFile << input.label << "," << fixed << setprecision(1) << inserted << "," << bulk << ","
+                    << setprecision(2) << inserted / bulk << endl;
+        }
+
+        cout << string(66, '-') << endl;
+        cout << "Bulk load times for unsorted input include sorting it first." << endl;
+        csvFile.close();
+        cout << endl << "Results exported to 'bulk_load_results.csv'" << endl;
+    }
+
+    // Builds throwaway Standard Tries with 1, 2, 4, ... threads up to the
+    // hardware thread count, best of three runs each, and prints the
+    // speedup over the single-threaded insert loop. Returns the thread
+    // count to use for the real build.
+    unsigned measureParallelBuild() {
+        const int RUNS = 3;
+        unsigned maxThreads = max(1u, thread::hardware_concurrency());
+        vector<unsigned> threadCounts;
+        for (unsigned count = 1; count < maxThreads; count *= 2) {
+            threadCounts.push_back(count);
+        }
+        threadCounts.push_back(maxThreads);
+
+        auto timeBuild = [&](unsigned threads) {
+            double best = 0;
+            for (int run = 0; run < RUNS; run++) {
+                auto start = high_resolution_clock::now();
+                Trie* candidate = new Trie();
+                if (threads == 0) {
+                    for (size_t i = 0; i < allWords.size(); i++) {
+                        candidate->insert(allWords[i], allWeights[i]);
+                    }
+                } else {
+                    candidate->buildParallel(allWords, allWeights, threads);
+                }
+                auto end = high_resolution_clock::now();
+                delete candidate;
+                double millis = duration_cast<microseconds>(end - start).count() / 1000.0;
+                best = (run == 0) ? millis : min(best, millis);
+            }
+            return best;
+        };
+
+        ofstream csvFile("trie_build_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return maxThreads;
+        }
+        csvFile << "Threads,Build (ms),Speedup" << endl;
+
+        cout << endl << "PARALLEL TRIE BUILD (" << allWords.size() << " words, best of " << RUNS << ", "
+             << maxThreads << " hardware threads):" << endl;
+        cout << string(40, '-') << endl;
+        cout << left << setw(14) << "Threads" << setw(14) << "Build ms" << "Speedup" << endl;
+        cout << string(40, '-') << endl;
+
+        double serial = timeBuild(0);
+        cout << left << setw(14) << "insert loop" << setw(14) << fixed << setprecision(1) << serial << "1.00" << endl;
+        csvFile << "serial," << fixed << setprecision(1) << serial << ",1.00" << endl;
+        for (unsigned threads : threadCounts) {
+            double millis = timeBuild(threads);
+            cout << left << setw(14) << threads << setw(14) << fixed << setprecision(1) << millis
+                 << setprecision(2) << serial / millis << endl;
+            csvFile << threads << "," << fixed << setprecision(1) << millis << "," << setprecision(2)
+                    << serial / millis << endl;
+        }
+        cout << string(40, '-') << endl;
+        csvFile.close();
+        cout << "Results exported to 'trie_build_results.csv'" << endl << endl;
+        return maxThreads;
+    }
+
+    void buildHashTable() {
+        if (allWords.empty()) {
+            cout << "Error: No words loaded. Please load a dataset first." << endl;
+            return;
+        }
+
+        int engineChoice;
+        cout << "Select engine (0 = Chained, 1 = Flat/Swiss, 2 = Chained with arena keys): ";
+        cin >> engineChoice;
+        if (engineChoice == 1) {
+            hashEngine = FLAT_HASH;
+        } else if (engineChoice == 2) {
+            hashEngine = ARENA_HASH;
+        } else {
+            hashEngine = CHAINED_HASH;
+        }
+
+        if (hashTable) delete hashTable;
+        if (flatHashSet) delete flatHashSet;
+        if (arenaHashTable) delete arenaHashTable;
+        hashTable = nullptr;
+        flatHashSet = nullptr;
+        arenaHashTable = nullptr;
+
+        cout << "Building " << hashEngineName() << " Hash Table with " << allWords.size() << " words..." << endl;
+
+        auto start = high_resolution_clock::now();
+        if (hashEngine == FLAT_HASH) {
+            flatHashSet = new FlatHashSet();
+            flatHashSet->reserve(allWords.size());
+            for (string_view word : allWords) {
+                flatHashSet->insert(word);
+            }
+        } else if (hashEngine == ARENA_HASH) {
+            arenaHashTable = new ArenaHashTable();
+            arenaHashTable->reserve(allWords.size());
+            for (string_view word : allWords) {
+                arenaHashTable->insert(word);
+            }
+        } else {
+            hashTable = new HashTable();
+            hashTable->reserve(allWords.size());
+            for (string_view word : allWords) {
+                hashTable->insert(word);
+            }
+        }
+        auto end = high_resolution_clock::now();
+        auto duration = duration_cast<milliseconds>(end - start);
+
+        hashBuildTime = duration.count();
+        hashTableBuilt = true;
+        cout << "Hash Table built successfully in " << hashBuildTime << " ms" << endl;
+    }
+
+    void buildFrozenDictionary() {
+        if (allWords.empty()) {
+            cout << "Error: No words loaded. Please load a dataset first." << endl;
+            return;
+        }
+
+        if (frozenDictionary) delete frozenDictionary;
+        frozenDictionary = nullptr;
+
+        cout << "Building Frozen Dictionary (minimal perfect hash) with " << allWords.size() << " words..." << endl;
+
+        auto start = high_resolution_clock::now();
+        frozenDictionary = new FrozenDictionary(allWords);
+        auto end = high_resolution_clock::now();
+        auto duration = duration_cast<milliseconds>(end - start);
+
+        frozenBuildTime = duration.count();
+        frozenMemory = frozenDictionary->memoryBytes();
+        frozenBuilt = true;
+        cout << "Frozen Dictionary built successfully in " << frozenBuildTime << " ms" << endl;
+        cout << "  - Distinct words: " << frozenDictionary->size() << endl;
+        cout << "  - Perfect hash: " << fixed << setprecision(2) << frozenDictionary->bitsPerKey() << " bits per key" << endl;
+        cout << "  - Total memory: ~" << (frozenMemory / 1024) << " KB" << endl;
+    }
+
+    void searchWord() {
+        if (!trieBuilt && !hashTableBuilt) {
+            cout << "Error: Please build at least one data structure first." << endl;
+            return;
+        }
+
+        string word;
+        cout << "Enter word to search: ";
+        cin >> word;
+        transform(word.begin(), word.end(), word.begin(), ::tolower);
+
+        if (bloomFilter) {
+            auto start = high_resolution_clock::now();
+            bool maybe = bloomFilter->mayContain(word);
+            auto end = high_resolution_clock::now();
+            auto duration = duration_cast<nanoseconds>(end - start);
+
+            cout << "Bloom filter: '" << word << "' " << (maybe ? "MAYBE PRESENT" : "DEFINITELY ABSENT")
+                 << " (Time: " << duration.count() << " ns)" << endl;
+        }
+
+        if (trieBuilt) {
+            auto start = high_resolution_clock::now();
+            bool found = trieSearch(word);
+            auto end = high_resolution_clock::now();
+            auto duration = duration_cast<nanoseconds>(end - start);
+
+            cout << "Trie: '" << word << "' " << (found ? "FOUND" : "NOT FOUND")
+                 << " (Time: " << duration.count() << " ns)" << endl;
+
+            if (trieEngine == LOUDS_TRIE) {
+                const size_t SHOWN = 10;
+                vector<string> matches = loudsTrie->withPrefix(word, SHOWN);
+                cout << "Words starting with '" << word << "':";
+                for (const string& match : matches) {
+                    cout << " " << match;
+                }
+                cout << (matches.size() == SHOWN ? " ..." : "") << endl;
+            }
+        }
+
+        if (hashTableBuilt) {
+            auto start = high_resolution_clock::now();
+            bool found = hashContains(word);
+            auto end = high_resolution_clock::now();
+            auto duration = duration_cast<nanoseconds>(end - start);
+
+            cout << "Hash Table: '" << word << "' " << (found ? "FOUND" : "NOT FOUND")
+                 << " (Time: " << duration.count() << " ns)" << endl;
+        }
     }
 
     void runBenchmark() {
@@ -256,34 +1377,79 @@ public:
 
         const int NUM_QUERIES = 1000;
         cout << endl << "Running benchmark with " << NUM_QUERIES << " random queries..." << endl;
+        cout << "Trie engine: " << trieEngineName() << ", Hash Table engine: " << hashEngineName() << endl;
         cout << string(60, '=') << endl;
 
         random_device rd;
         mt19937 gen(rd());
         uniform_int_distribution<> dis(0, allWords.size() - 1);
 
-        vector<string> queryWords;
+        // Queries are views into one text buffer, the way tokens arrive
+        // from a parsed line, so no std::string is built per query.
+        string queryText;
         for (int i = 0; i < NUM_QUERIES; i++) {
-            queryWords.push_back(allWords[dis(gen)]);
+            queryText += allWords[dis(gen)];
+            queryText += ' ';
+        }
+
+        vector<string_view> queryWords;
+        queryWords.reserve(NUM_QUERIES);
+        size_t tokenStart = 0;
+        for (size_t i = 0; i < queryText.size(); i++) {
+            if (queryText[i] == ' ') {
+                queryWords.push_back(string_view(queryText).substr(tokenStart, i - tokenStart));
+                tokenStart = i + 1;
+            }
         }
 
         // Benchmark Trie
+        size_t allocationsBefore = heapAllocations.load();
         auto trieStart = high_resolution_clock::now();
         int trieFound = 0;
-        for (const string& word : queryWords) {
-            if (trie->search(word)) trieFound++;
+        for (string_view word : queryWords) {
+            if (trieSearch(word)) trieFound++;
         }
         auto trieEnd = high_resolution_clock::now();
         auto trieDuration = duration_cast<microseconds>(trieEnd - trieStart);
+        trieQueryAllocations = heapAllocations.load() - allocationsBefore;
 
         // Benchmark Hash Table
+        if (hashEngine == CHAINED_HASH) {
+            hashTable->resetCounters();
+        } else if (hashEngine == ARENA_HASH) {
+            arenaHashTable->resetCounters();
+        }
+        allocationsBefore = heapAllocations.load();
         auto hashStart = high_resolution_clock::now();
         int hashFound = 0;
-        for (const string& word : queryWords) {
-            if (hashTable->contains(word)) hashFound++;
+        for (string_view word : queryWords) {
+            if (hashContains(word)) hashFound++;
         }
         auto hashEnd = high_resolution_clock::now();
         auto hashDuration = duration_cast<microseconds>(hashEnd - hashStart);
+        hashQueryAllocations = heapAllocations.load() - allocationsBefore;
+        if (hashEngine == CHAINED_HASH) {
+            recordChainStats(*hashTable);
+        } else if (hashEngine == ARENA_HASH) {
+            recordChainStats(*arenaHashTable);
+        } else {
+            hashShapeKnown = false;
+        }
+
+        // Benchmark Frozen Dictionary (optional)
+        int frozenFound = 0;
+        long long frozenMicros = 0;
+        if (frozenBuilt) {
+            allocationsBefore = heapAllocations.load();
+            auto frozenStart = high_resolution_clock::now();
+            for (string_view word : queryWords) {
+                if (frozenDictionary->contains(word)) frozenFound++;
+            }
+            auto frozenEnd = high_resolution_clock::now();
+            frozenQueryAllocations = heapAllocations.load() - allocationsBefore;
+            frozenMicros = duration_cast<microseconds>(frozenEnd - frozenStart).count();
+            frozenAvgLookup = frozenMicros / (double)NUM_QUERIES;
+        }
 
         // Store results
         trieAvgLookup = trieDuration.count() / (double)NUM_QUERIES;
@@ -302,6 +1468,14 @@ public:
         cout << left << setw(30) << "Avg time per query (μs):"
              << setw(15) << fixed << setprecision(3) << trieAvgLookup
              << setw(15) << fixed << setprecision(3) << hashAvgLookup << endl;
+        cout << left << setw(30) << "Heap allocations:" << setw(15) << trieQueryAllocations
+             << setw(15) << hashQueryAllocations << endl;
+
+        if (frozenBuilt) {
+            cout << left << setw(30) << "Frozen Dictionary:" << frozenFound << " found, "
+                 << frozenMicros << " μs total, " << fixed << setprecision(3) << frozenAvgLookup
+                 << " μs per query" << endl;
+        }
 
         cout << string(60, '-') << endl;
 
@@ -320,6 +1494,869 @@ public:
         createTextReport();
     }
 
+    void runHashPolicyBenchmark() {
+        if (allWords.empty()) {
+            cout << "Error: No words loaded. Please load a dataset first." << endl;
+            return;
+        }
+
+        ofstream csvFile("hash_policy_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Hasher,Reducer,Buckets,Hash ns/key,Chi-Square,Chi-Square/df" << endl;
+
+        cout << endl << "HASH FUNCTION BENCHMARK (" << allWords.size() << " words, load factor ~1.0):" << endl;
+        cout << string(72, '-') << endl;
+        cout << left << setw(12) << "Hasher" << setw(16) << "Reducer" << setw(10) << "Buckets"
+             << setw(10) << "ns/key" << setw(14) << "Chi-Square" << "Chi^2/df" << endl;
+        cout << string(72, '-') << endl;
+
+        benchmarkHasher<StdHash>(csvFile);
+        benchmarkHasher<Fnv1aHash>(csvFile);
+        benchmarkHasher<WyHash>(csvFile);
+        benchmarkHasher<Crc32Hash>(csvFile);
+
+        cout << string(72, '-') << endl;
+        cout << "Chi^2/df near 1.0 means the hasher spreads keys like a random function." << endl;
+
+        csvFile.close();
+        cout << endl << "Results exported to 'hash_policy_results.csv'" << endl;
+    }
+
+    // Builds one trie layout over every loaded word, measuring its real
+    // heap footprint, then times lookups for the shared query set.
+    template <typename TrieType>
+    void benchmarkTrieLayout(const vector<string>& queries, ofstream& csvFile) {
+        const int ROUNDS = 5;
+
+        size_t bytesBefore = heapBytesInUse.load();
+        TrieType* layoutTrie = new TrieType();
+        auto start = high_resolution_clock::now();
+        try {
+            for (string_view word : allWords) {
+                layoutTrie->insert(word);
+            }
+        } catch (const invalid_argument& error) {
+            delete layoutTrie;
+            cout << left << setw(16) << TrieType::layoutName() << "skipped: " << error.what() << endl;
+            csvFile << TrieType::layoutName() << ",N/A,N/A,N/A,N/A,N/A,N/A,N/A" << endl;
+            return;
+        }
+        auto end = high_resolution_clock::now();
+        long long buildMs = duration_cast<milliseconds>(end - start).count();
+        size_t bytes = heapBytesInUse.load() - bytesBefore;
+
+        size_t found = 0;
+        start = high_resolution_clock::now();
+        for (int round = 0; round < ROUNDS; round++) {
+            for (const string& word : queries) {
+                if (layoutTrie->search(word)) found++;
+            }
+        }
+        end = high_resolution_clock::now();
+        double nsPerLookup = duration_cast<nanoseconds>(end - start).count()
+                             / ((double)ROUNDS * queries.size());
+        // Stored so the compiler cannot drop the timed loop.
+        volatile size_t sink = found;
+        (void)sink;
+
+        size_t hops = 0;
+        for (const string& word : queries) {
+            hops += layoutTrie->pathLength(word);
+        }
+        double hopsPerLookup = hops / (double)queries.size();
+
+        size_t nodeCount = layoutTrie->nodeCount();
+        double bytesPerNode = bytes / (double)nodeCount;
+
+        start = high_resolution_clock::now();
+        delete layoutTrie;
+        end = high_resolution_clock::now();
+        double freeMs = duration_cast<microseconds>(end - start).count() / 1000.0;
+
+        cout << left << setw(16) << TrieType::layoutName() << setw(10) << buildMs
+             << setw(10) << fixed << setprecision(2) << freeMs
+             << setw(12) << fixed << setprecision(1) << nsPerLookup
+             << setw(12) << fixed << setprecision(1) << (bytes / 1024.0 / 1024.0)
+             << setw(10) << nodeCount << setw(8) << fixed << setprecision(1) << bytesPerNode
+             << fixed << setprecision(2) << hopsPerLookup << endl;
+
+        csvFile << TrieType::layoutName() << "," << buildMs << "," << fixed << setprecision(2) << freeMs << ","
+                << setprecision(1) << nsPerLookup << "," << (bytes / 1024.0 / 1024.0) << "," << nodeCount << ","
+                << bytesPerNode << "," << setprecision(2) << hopsPerLookup << endl;
+    }
+
+    // Half the queries are dictionary words, the other half the same kind
+    // of word with one random letter inserted, which nearly always misses.
+    // Seeded, so every structure is timed on the same queries.
+    vector<string> makeMixedQueries(size_t count) {
+        mt19937 gen(42);
+        vector<string> queries;
+        queries.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            string word(allWords[gen() % allWords.size()]);
+            if (i % 2 == 1) {
+                word.insert(word.begin() + gen() % (word.size() + 1), (char)('a' + gen() % 26));
+            }
+            queries.push_back(word);
+        }
+        return queries;
+    }
+
+    void runTrieLayoutBenchmark() {
+        if (allWords.empty()) {
+            cout << "Error: No words loaded. Please load a dataset first." << endl;
+            return;
+        }
+
+        const size_t NUM_QUERIES = 200000;
+        vector<string> queries = makeMixedQueries(NUM_QUERIES);
+
+        ofstream csvFile("trie_layout_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Layout,Build (ms),Free (ms),Lookup ns,Memory (MB),Nodes,Bytes/Node,Hops/Lookup" << endl;
+
+        cout << endl << "TRIE NODE LAYOUT BENCHMARK (" << allWords.size() << " words, "
+             << NUM_QUERIES << " queries, ~50% hits):" << endl;
+        cout << string(76, '-') << endl;
+        cout << left << setw(16) << "Layout" << setw(10) << "Build ms" << setw(10) << "Free ms"
+             << setw(12) << "Lookup ns" << setw(12) << "Memory MB" << setw(10) << "Nodes" << setw(8) << "B/node"
+             << "Hops" << endl;
+        cout << string(76, '-') << endl;
+
+        benchmarkTrieLayout<MapTrie>(queries, csvFile);
+        benchmarkTrieLayout<Trie>(queries, csvFile);
+        benchmarkTrieLayout<DirectTrie>(queries, csvFile);
+        benchmarkTrieLayout<BitmapTrie>(queries, csvFile);
+        benchmarkTrieLayout<RadixTrie>(queries, csvFile);
+
+        cout << string(76, '-') << endl;
+        cout << "Memory is the measured heap growth while building, allocator rounding included." << endl;
+        cout << "Hops is the average number of child links a lookup follows." << endl;
+
+        csvFile.close();
+        cout << endl << "Results exported to 'trie_layout_results.csv'" << endl;
+    }
+
+    template <typename Structure>
+    double timeLookups(const Structure& structure, const vector<string>& queries, size_t& found) {
+        const int ROUNDS = 5;
+        auto start = high_resolution_clock::now();
+        for (int round = 0; round < ROUNDS; round++) {
+            for (const string& word : queries) {
+                if (structure.search(word)) found++;
+            }
+        }
+        auto end = high_resolution_clock::now();
+        return duration_cast<nanoseconds>(end - start).count() / ((double)ROUNDS * queries.size());
+    }
+
+    void freezeTrie() {
+        if (!trieBuilt || trieEngine != STANDARD_TRIE) {
+            cout << "Error: Build the Standard Trie (option 1, engine 0) before freezing it." << endl;
+            return;
+        }
+
+        if (doubleArrayTrie) delete doubleArrayTrie;
+        doubleArrayTrie = nullptr;
+
+        cout << "Freezing Trie into a double array..." << endl;
+        auto start = high_resolution_clock::now();
+        doubleArrayTrie = new DoubleArrayTrie(trie->freeze());
+        auto end = high_resolution_clock::now();
+        long long freezeMs = duration_cast<milliseconds>(end - start).count();
+
+        cout << "Double-array Trie built in " << freezeMs << " ms" << endl;
+        cout << "  - Cells: " << doubleArrayTrie->cellCount() << " (" << fixed << setprecision(1)
+             << 100.0 * doubleArrayTrie->usedCells() / doubleArrayTrie->cellCount() << "% used)" << endl;
+
+        // The succinct form is built for the comparison only.
+        cout << "Encoding Trie as LOUDS..." << endl;
+        start = high_resolution_clock::now();
+        vector<string> trieWords = trie->words();
+        LoudsTrie louds(vector<string_view>(trieWords.begin(), trieWords.end()));
+        end = high_resolution_clock::now();
+        cout << "LOUDS Trie built in " << duration_cast<milliseconds>(end - start).count() << " ms" << endl;
+
+        vector<string> queries = makeMixedQueries(200000);
+        size_t found[3] = {0, 0, 0};
+        double nsPerLookup[3];
+        nsPerLookup[0] = timeLookups(*trie, queries, found[0]);
+        nsPerLookup[1] = timeLookups(*doubleArrayTrie, queries, found[1]);
+        nsPerLookup[2] = timeLookups(louds, queries, found[2]);
+
+        size_t words = doubleArrayTrie->size();
+        size_t nodes = trie->nodeCount();
+        size_t bytes[3] = {trieMemory, doubleArrayTrie->memoryBytes(), louds.memoryBytes()};
+        const char* names[3] = {"Trie", "Double-array", "LOUDS"};
+
+        cout << endl << "FROZEN TRIE COMPARISON (" << queries.size() << " queries, ~50% hits):" << endl;
+        cout << string(68, '-') << endl;
+        cout << left << setw(16) << "Structure" << setw(12) << "Lookup ns" << setw(14) << "Memory MB"
+             << setw(14) << "Bytes/word" << "Bits/node" << endl;
+        cout << string(68, '-') << endl;
+
+        ofstream csvFile("double_array_results.csv");
+        if (csvFile.is_open()) {
+            csvFile << "Structure,Lookup ns,Memory (MB),Bytes/Word,Bits/Node" << endl;
+        }
+        for (int i = 0; i < 3; i++) {
+            cout << left << setw(16) << names[i] << setw(12) << fixed << setprecision(1) << nsPerLookup[i]
+                 << setw(14) << setprecision(2) << (bytes[i] / 1024.0 / 1024.0)
+                 << setw(14) << (double)bytes[i] / words << (8.0 * bytes[i] / nodes) << endl;
+            if (csvFile.is_open()) {
+                csvFile << names[i] << "," << fixed << setprecision(1) << nsPerLookup[i] << ","
+                        << setprecision(2) << (bytes[i] / 1024.0 / 1024.0) << "," << (double)bytes[i] / words
+                        << "," << (8.0 * bytes[i] / nodes) << endl;
+            }
+        }
+        cout << string(68, '-') << endl;
+        if (found[0] != found[1] || found[0] != found[2]) {
+            cout << "Warning: the structures disagree (" << found[0] << ", " << found[1] << ", "
+                 << found[2] << " found)" << endl;
+        }
+
+        if (csvFile.is_open()) {
+            csvFile.close();
+            cout << endl << "Results exported to 'double_array_results.csv'" << endl;
+        }
+    }
+
+    bool autocompleteAvailable() {
+        if (!trieBuilt || trieEngine != STANDARD_TRIE) {
+            cout << "Error: Autocomplete needs the Standard Trie (option 1, engine 0)." << endl;
+            return false;
+        }
+        return true;
+    }
+
+    void autocompleteWord() {
+        if (!autocompleteAvailable()) {
+            return;
+        }
+
+        string prefix;
+        size_t k;
+        cout << "Enter prefix: ";
+        cin >> prefix;
+        cout << "How many completions (k): ";
+        cin >> k;
+        transform(prefix.begin(), prefix.end(), prefix.begin(), ::tolower);
+
+        auto start = high_resolution_clock::now();
+        vector<Completion> completions = trie->autocomplete(prefix, k);
+        auto end = high_resolution_clock::now();
+
+        cout << "Top " << completions.size() << " completions for '" << prefix << "' ("
+             << duration_cast<microseconds>(end - start).count() << " μs):" << endl;
+        for (size_t i = 0; i < completions.size(); i++) {
+            cout << "  " << right << setw(3) << (i + 1) << ". " << left << setw(24) << completions[i].word
+                 << "weight " << completions[i].weight << endl;
+        }
+    }
+
+    // Brute-force baseline for fuzzy search: the edit distance from a to
+    // b, computed with two DP rows.
+    static size_t editDistance(string_view a, string_view b) {
+        vector<size_t> previous(b.size() + 1), current(b.size() + 1);
+        for (size_t j = 0; j <= b.size(); j++) {
+            previous[j] = j;
+        }
+        for (size_t i = 1; i <= a.size(); i++) {
+            current[0] = i;
+            for (size_t j = 1; j <= b.size(); j++) {
+                current[j] = min(min(previous[j], current[j - 1]) + 1,
+                                 previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1));
+            }
+            swap(previous, current);
+        }
+        return previous[b.size()];
+    }
+
+    // Every loaded word within maxEdits of query, checked one by one.
+    // Words whose length alone rules them out are skipped.
+    vector<FuzzyMatch> bruteForceFuzzy(const string& query, size_t maxEdits) {
+        vector<FuzzyMatch> matches;
+        for (string_view word : allWords) {
+            size_t lengthGap = word.size() > query.size() ? word.size() - query.size() : query.size() - word.size();
+            if (lengthGap > maxEdits) {
+                continue;
+            }
+            size_t distance = editDistance(word, query);
+            if (distance <= maxEdits) {
+                matches.push_back(FuzzyMatch{string(word), distance});
+            }
+        }
+        return matches;
+    }
+
+    void fuzzySearchWord() {
+        if (!autocompleteAvailable()) {
+            return;
+        }
+
+        string word;
+        size_t maxEdits;
+        cout << "Enter word: ";
+        cin >> word;
+        cout << "Maximum edit distance (1-2 recommended): ";
+        cin >> maxEdits;
+        transform(word.begin(), word.end(), word.begin(), ::tolower);
+
+        auto start = high_resolution_clock::now();
+        vector<FuzzyMatch> matches = trie->fuzzySearch(word, maxEdits);
+        auto end = high_resolution_clock::now();
+        long long trieMicros = duration_cast<microseconds>(end - start).count();
+
+        start = high_resolution_clock::now();
+        size_t bruteMatches = bruteForceFuzzy(word, maxEdits).size();
+        end = high_resolution_clock::now();
+        long long bruteMicros = duration_cast<microseconds>(end - start).count();
+
+        const size_t SHOWN = 20;
+        cout << matches.size() << " words within " << maxEdits << " edits of '" << word << "':" << endl;
+        for (size_t i = 0; i < matches.size() && i < SHOWN; i++) {
+            cout << "  " << left << setw(24) << matches[i].word << "distance " << matches[i].distance << endl;
+        }
+        if (matches.size() > SHOWN) {
+            cout << "  ... and " << (matches.size() - SHOWN) << " more" << endl;
+        }
+        cout << "Trie walk: " << trieMicros << " μs, brute force over " << allWords.size()
+             << " words: " << bruteMicros << " μs (" << bruteMatches << " matches)" << endl;
+    }
+
+    // Fuzzy lookups of misspelled words (one random edit away from a
+    // loaded word) at edit distance 1 and 2, trie walk against brute
+    // force. Brute force is slow, so it gets fewer queries.
+    void runFuzzyBenchmark() {
+        if (!autocompleteAvailable()) {
+            return;
+        }
+
+        const size_t TRIE_QUERIES = 500;
+        const size_t BRUTE_QUERIES = 20;
+
+        mt19937 gen(42);
+        vector<string> queries;
+        for (size_t i = 0; i < TRIE_QUERIES; i++) {
+            string word(allWords[gen() % allWords.size()]);
+            size_t position = gen() % word.size();
+            char letter = (char)('a' + gen() % 26);
+            switch (gen() % 3) {
+                case 0: word[position] = letter; break;
+                case 1: word.insert(word.begin() + position, letter); break;
+                default: if (word.size() > 1) word.erase(position, 1); break;
+            }
+            queries.push_back(word);
+        }
+
+        ofstream csvFile("fuzzy_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Max Edits,Trie Avg μs,Brute Force Avg μs,Speedup,Avg Matches" << endl;
+
+        cout << endl << "FUZZY SEARCH BENCHMARK (" << TRIE_QUERIES << " trie / " << BRUTE_QUERIES
+             << " brute-force queries, one random edit each):" << endl;
+        cout << string(66, '-') << endl;
+        cout << left << setw(12) << "Max Edits" << setw(14) << "Trie μs" << setw(18) << "Brute Force μs"
+             << setw(12) << "Speedup" << "Matches" << endl;
+        cout << string(66, '-') << endl;
+
+        for (size_t maxEdits = 1; maxEdits <= 2; maxEdits++) {
+            size_t totalMatches = 0;
+            auto start = high_resolution_clock::now();
+            for (const string& query : queries) {
+                totalMatches += trie->fuzzySearch(query, maxEdits).size();
+            }
+            auto end = high_resolution_clock::now();
+            double trieMicros = duration_cast<nanoseconds>(end - start).count() / 1000.0 / queries.size();
+
+            vector<size_t> bruteCounts(BRUTE_QUERIES);
+            start = high_resolution_clock::now();
+            for (size_t i = 0; i < BRUTE_QUERIES; i++) {
+                bruteCounts[i] = bruteForceFuzzy(queries[i], maxEdits).size();
+            }
+            end = high_resolution_clock::now();
+            double bruteMicros = duration_cast<nanoseconds>(end - start).count() / 1000.0 / BRUTE_QUERIES;
+
+            // Checked outside the timed loops so neither side pays for it.
+            size_t disagreements = 0;
+            for (size_t i = 0; i < BRUTE_QUERIES; i++) {
+                if (bruteCounts[i] != trie->fuzzySearch(queries[i], maxEdits).size()) {
+                    disagreements++;
+                }
+            }
+
+            double averageMatches = (double)totalMatches / queries.size();
+            cout << left << setw(12) << maxEdits << setw(14) << fixed << setprecision(1) << trieMicros
+                 << setw(18) << bruteMicros << setw(12) << setprecision(0) << bruteMicros / trieMicros
+                 << setprecision(1) << averageMatches << endl;
+            csvFile << maxEdits << "," << fixed << setprecision(1) << trieMicros << "," << bruteMicros << ","
+                    << setprecision(1) << bruteMicros / trieMicros << "," << averageMatches << endl;
+            if (disagreements > 0) {
+                cout << "Warning: trie and brute force disagreed on " << disagreements << " queries" << endl;
+            }
+        }
+
+        cout << string(66, '-') << endl;
+        csvFile.close();
+        cout << endl << "Results exported to 'fuzzy_results.csv'" << endl;
+    }
+
+    // The regex equivalent of a wildcard pattern, for the scan baseline.
+    static regex wildcardRegex(const string& pattern) {
+        string expression;
+        for (char c : pattern) {
+            if (c == '?') {
+                expression += ".";
+            } else if (c == '*') {
+                expression += ".*";
+            } else {
+                expression += c;
+            }
+        }
+        return regex(expression, regex::optimize);
+    }
+
+    void matchPattern() {
+        if (!autocompleteAvailable()) {
+            return;
+        }
+
+        string pattern;
+        cout << "Enter pattern ('?' = any letter, '*' = any run of letters): ";
+        cin >> pattern;
+        transform(pattern.begin(), pattern.end(), pattern.begin(), ::tolower);
+
+        auto start = high_resolution_clock::now();
+        vector<string> matches = trie->match(pattern);
+        auto end = high_resolution_clock::now();
+
+        const size_t SHOWN = 20;
+        cout << matches.size() << " words match '" << pattern << "' ("
+             << duration_cast<microseconds>(end - start).count() << " μs):";
+        for (size_t i = 0; i < matches.size() && i < SHOWN; i++) {
+            cout << " " << matches[i];
+        }
+        cout << (matches.size() > SHOWN ? " ..." : "") << endl;
+    }
+
+    // Times a set of crossword and affix patterns on the trie against a
+    // std::regex scan of every loaded word.
+    void runPatternBenchmark() {
+        if (!autocompleteAvailable()) {
+            return;
+        }
+
+        const vector<string> patterns = {
+            "c?t", "?????", "pre*ion", "*ing", "un*able", "s*s", "??x??", "a*b*c", "*q*", "th?n*",
+        };
+        const int ROUNDS = 5;
+
+        ofstream csvFile("pattern_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Pattern,Matches,Trie μs,Regex Scan μs,Speedup" << endl;
+
+        cout << endl << "WILDCARD PATTERN BENCHMARK (" << allWords.size() << " words):" << endl;
+        cout << string(64, '-') << endl;
+        cout << left << setw(12) << "Pattern" << setw(10) << "Matches" << setw(14) << "Trie μs"
+             << setw(16) << "Regex Scan μs" << "Speedup" << endl;
+        cout << string(64, '-') << endl;
+
+        for (const string& pattern : patterns) {
+            size_t matches = 0;
+            auto start = high_resolution_clock::now();
+            for (int round = 0; round < ROUNDS; round++) {
+                matches = trie->match(pattern).size();
+            }
+            auto end = high_resolution_clock::now();
+            double trieMicros = duration_cast<nanoseconds>(end - start).count() / 1000.0 / ROUNDS;
+
+            regex expression = wildcardRegex(pattern);
+            size_t scanMatches = 0;
+            start = high_resolution_clock::now();
+            for (string_view word : allWords) {
+                if (regex_match(word.begin(), word.end(), expression)) {
+                    scanMatches++;
+                }
+            }
+            end = high_resolution_clock::now();
+            double scanMicros = duration_cast<nanoseconds>(end - start).count() / 1000.0;
+
+            cout << left << setw(12) << pattern << setw(10) << matches << setw(14) << fixed << setprecision(1)
+                 << trieMicros << setw(16) << scanMicros << setprecision(0) << scanMicros / trieMicros << "x";
+            if (scanMatches != matches) {
+                cout << "  (scan found " << scanMatches << ")";
+            }
+            cout << endl;
+            csvFile << pattern << "," << matches << "," << fixed << setprecision(1) << trieMicros << ","
+                    << scanMicros << "," << scanMicros / trieMicros << endl;
+        }
+
+        cout << string(64, '-') << endl;
+        csvFile.close();
+        cout << endl << "Results exported to 'pattern_results.csv'" << endl;
+    }
+
+    // Pages through the words under a prefix with the lazy iterator. Each
+    // page only walks as far as the words it shows, and the match count
+    // comes from the subtree counts without visiting the matches.
+    void browsePrefix() {
+        if (!autocompleteAvailable()) {
+            return;
+        }
+
+        string prefix;
+        size_t pageSize;
+        cout << "Enter prefix: ";
+        cin >> prefix;
+        cout << "Words per page: ";
+        cin >> pageSize;
+        transform(prefix.begin(), prefix.end(), prefix.begin(), ::tolower);
+        pageSize = max(pageSize, (size_t)1);
+
+        auto start = high_resolution_clock::now();
+        size_t total = trie->countWithPrefix(prefix);
+        auto end = high_resolution_clock::now();
+        cout << total << " words start with '" << prefix << "' (counted in "
+             << duration_cast<nanoseconds>(end - start).count() << " ns)" << endl;
+
+        // For comparison: what it costs to copy out every match up front.
+        start = high_resolution_clock::now();
+        vector<string> everything;
+        for (string_view word : trie->withPrefix(prefix)) {
+            everything.emplace_back(word);
+        }
+        end = high_resolution_clock::now();
+        cout << "Copying all of them into strings takes "
+             << duration_cast<microseconds>(end - start).count() << " μs" << endl;
+
+        auto range = trie->withPrefix(prefix);
+        auto it = range.begin();
+        size_t shown = 0;
+        while (it != range.end()) {
+            start = high_resolution_clock::now();
+            string page;
+            for (size_t i = 0; i < pageSize && it != range.end(); i++, ++it) {
+                page += "  ";
+                page += *it;
+                page += "\n";
+            }
+            end = high_resolution_clock::now();
+            shown = min(shown + pageSize, total);
+
+            cout << page << "(" << shown << " of " << total << ", page took "
+                 << duration_cast<nanoseconds>(end - start).count() << " ns)" << endl;
+            if (it == range.end()) {
+                break;
+            }
+
+            char more;
+            cout << "Next page? (y/n): ";
+            cin >> more;
+            if (tolower(more) != 'y') {
+                break;
+            }
+        }
+    }
+
+    // Times autocomplete for every prefix of length 1, 2 and 3 that
+    // occurs in the data. Short prefixes have the largest subtrees, so
+    // they are the worst case for any approach that enumerates.
+    void runAutocompleteBenchmark() {
+        if (!autocompleteAvailable()) {
+            return;
+        }
+
+        const size_t K = 10;
+        const int ROUNDS = 3;
+
+        ofstream csvFile("autocomplete_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Prefix Length,Prefixes,Avg μs,P99 μs,Max μs,Slowest Prefix" << endl;
+
+        cout << endl << "AUTOCOMPLETE BENCHMARK (top " << K << ", every prefix of length 1-3):" << endl;
+        cout << string(72, '-') << endl;
+        cout << left << setw(10) << "Length" << setw(12) << "Prefixes" << setw(12) << "Avg μs"
+             << setw(12) << "P99 μs" << setw(12) << "Max μs" << "Slowest" << endl;
+        cout << string(72, '-') << endl;
+
+        for (size_t length = 1; length <= 3; length++) {
+            vector<string> prefixes;
+            for (string_view word : allWords) {
+                if (word.size() >= length) {
+                    prefixes.emplace_back(word.substr(0, length));
+                }
+            }
+            sort(prefixes.begin(), prefixes.end());
+            prefixes.erase(unique(prefixes.begin(), prefixes.end()), prefixes.end());
+
+            vector<double> micros;
+            for (const string& prefix : prefixes) {
+                auto start = high_resolution_clock::now();
+                for (int round = 0; round < ROUNDS; round++) {
+                    trie->autocomplete(prefix, K);
+                }
+                auto end = high_resolution_clock::now();
+                micros.push_back(duration_cast<nanoseconds>(end - start).count() / 1000.0 / ROUNDS);
+            }
+
+            size_t slowest = max_element(micros.begin(), micros.end()) - micros.begin();
+            double average = 0;
+            for (double value : micros) {
+                average += value;
+            }
+            average /= micros.size();
+            vector<double> sorted = micros;
+            sort(sorted.begin(), sorted.end());
+            double p99 = sorted[min(sorted.size() - 1, sorted.size() * 99 / 100)];
+
+            cout << left << setw(10) << length << setw(12) << prefixes.size()
+                 << setw(12) << fixed << setprecision(2) << average << setw(12) << p99
+                 << setw(12) << micros[slowest] << prefixes[slowest] << endl;
+            csvFile << length << "," << prefixes.size() << "," << fixed << setprecision(2) << average << ","
+                    << p99 << "," << micros[slowest] << "," << prefixes[slowest] << endl;
+        }
+
+        cout << string(72, '-') << endl;
+        csvFile.close();
+        cout << endl << "Results exported to 'autocomplete_results.csv'" << endl;
+    }
+
+    void runBatchLookupBenchmark() {
+        if (!hashTableBuilt) {
+            cout << "Error: Please build the Hash Table first." << endl;
+            return;
+        }
+
+        if (hashEngine == CHAINED_HASH) {
+            benchmarkBatchLookups(*hashTable);
+        } else if (hashEngine == ARENA_HASH) {
+            benchmarkBatchLookups(*arenaHashTable);
+        } else {
+            cout << "Error: Batch lookups need a chained engine (0 or 2). Please rebuild the Hash Table." << endl;
+        }
+    }
+
+    void runConcurrentBenchmark() {
+        if (allWords.empty()) {
+            cout << "Error: No words loaded. Please load a dataset first." << endl;
+            return;
+        }
+
+        const size_t OPS_PER_THREAD = 500000;
+
+        ConcurrentHashTable table(allWords.size());
+        for (string_view word : allWords) {
+            table.insert(word);
+        }
+
+        unsigned maxThreads = max(1u, thread::hardware_concurrency());
+        vector<unsigned> threadCounts;
+        for (unsigned count = 1; count < maxThreads; count *= 2) {
+            threadCounts.push_back(count);
+        }
+        threadCounts.push_back(maxThreads);
+
+        ofstream csvFile("concurrent_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Threads,99/1 Mops/s,99/1 Scaling,90/10 Mops/s,90/10 Scaling" << endl;
+
+        cout << endl << "CONCURRENT HASH TABLE BENCHMARK (" << OPS_PER_THREAD << " ops per thread, "
+             << maxThreads << " hardware threads):" << endl;
+        cout << string(70, '-') << endl;
+        cout << left << setw(10) << "Threads" << setw(15) << "99/1 Mops/s" << setw(15) << "Scaling"
+             << setw(15) << "90/10 Mops/s" << "Scaling" << endl;
+        cout << string(70, '-') << endl;
+
+        double readHeavyBase = 0;
+        double mixedBase = 0;
+        for (unsigned threads : threadCounts) {
+            double readHeavy = measureConcurrentThroughput(table, threads, OPS_PER_THREAD, 99);
+            double mixed = measureConcurrentThroughput(table, threads, OPS_PER_THREAD, 90);
+            if (threads == 1) {
+                readHeavyBase = readHeavy;
+                mixedBase = mixed;
+            }
+
+            cout << left << setw(10) << threads
+                 << setw(15) << fixed << setprecision(2) << readHeavy
+                 << setw(15) << (readHeavy / readHeavyBase)
+                 << setw(15) << mixed << (mixed / mixedBase) << endl;
+            csvFile << threads << "," << fixed << setprecision(2) << readHeavy << ","
+                    << (readHeavy / readHeavyBase) << "," << mixed << "," << (mixed / mixedBase) << endl;
+        }
+
+        cout << string(70, '-') << endl;
+        cout << "Words still stored: " << table.size() << " (writes insert and then erase private keys)" << endl;
+
+        csvFile.close();
+        cout << endl << "Results exported to 'concurrent_results.csv'" << endl;
+    }
+
+    void buildBloomFilter() {
+        if (allWords.empty()) {
+            cout << "Error: No words loaded. Please load a dataset first." << endl;
+            return;
+        }
+
+        double falsePositiveRate;
+        cout << "Enter target false-positive rate (e.g., 0.01): ";
+        cin >> falsePositiveRate;
+
+        if (bloomFilter) delete bloomFilter;
+        bloomFilter = nullptr;
+
+        auto start = high_resolution_clock::now();
+        bloomFilter = new BloomFilter(allWords.size(), falsePositiveRate);
+        for (string_view word : allWords) {
+            bloomFilter->insert(word);
+        }
+        auto end = high_resolution_clock::now();
+        auto duration = duration_cast<milliseconds>(end - start);
+
+        cout << "Bloom filter built successfully in " << duration.count() << " ms" << endl;
+        cout << "  - Blocks (64 bytes each): " << bloomFilter->blockCount() << endl;
+        cout << "  - Hash functions: " << bloomFilter->hashCount() << endl;
+        cout << "  - Size: ~" << (bloomFilter->memoryBytes() / 1024) << " KB ("
+             << fixed << setprecision(2) << bloomFilter->bitsPerKey() << " bits per word)" << endl;
+    }
+
+    // Returns a word that is not in the dictionary, made by inserting a
+    // random letter into a random dictionary word.
+    string makeMissingWord(mt19937& gen) {
+        while (true) {
+            string candidate(allWords[gen() % allWords.size()]);
+            candidate.insert(candidate.begin() + gen() % (candidate.size() + 1), (char)('a' + gen() % 26));
+            if (!hashContains(candidate)) {
+                return candidate;
+            }
+        }
+    }
+
+    void runMissHeavyBenchmark() {
+        if (!trieBuilt || !hashTableBuilt) {
+            cout << "Error: Both Trie and Hash Table must be built before benchmarking." << endl;
+            return;
+        }
+        if (!bloomFilter) {
+            cout << "Error: Please build the Bloom filter first (option 11)." << endl;
+            return;
+        }
+
+        int missPercent;
+        cout << "Enter miss ratio in percent (0-100): ";
+        cin >> missPercent;
+        missPercent = max(0, min(100, missPercent));
+
+        const int NUM_QUERIES = 100000;
+        random_device rd;
+        mt19937 gen(rd());
+
+        vector<string> queryWords;
+        queryWords.reserve(NUM_QUERIES);
+        for (int i = 0; i < NUM_QUERIES; i++) {
+            if ((int)(gen() % 100) < missPercent) {
+                queryWords.push_back(makeMissingWord(gen));
+            } else {
+                queryWords.emplace_back(allWords[gen() % allWords.size()]);
+            }
+        }
+
+        int falsePositives = 0;
+        int misses = 0;
+        for (const string& word : queryWords) {
+            bool present = hashContains(word);
+            if (!present) {
+                misses++;
+                if (bloomFilter->mayContain(word)) falsePositives++;
+            }
+        }
+
+        // Plain lookups, then the same lookups screened by the filter
+        int found[4] = {0, 0, 0, 0};
+        long long micros[4];
+
+        auto start = high_resolution_clock::now();
+        for (const string& word : queryWords) {
+            if (trieSearch(word)) found[0]++;
+        }
+        micros[0] = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+        start = high_resolution_clock::now();
+        for (const string& word : queryWords) {
+            if (bloomFilter->mayContain(word) && trieSearch(word)) found[1]++;
+        }
+        micros[1] = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+        start = high_resolution_clock::now();
+        for (const string& word : queryWords) {
+            if (hashContains(word)) found[2]++;
+        }
+        micros[2] = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+        start = high_resolution_clock::now();
+        for (const string& word : queryWords) {
+            if (bloomFilter->mayContain(word) && hashContains(word)) found[3]++;
+        }
+        micros[3] = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+        double falsePositiveRate = misses == 0 ? 0 : (double)falsePositives / misses;
+
+        cout << endl << "MISS-HEAVY BENCHMARK (" << NUM_QUERIES << " queries, " << missPercent << "% misses):" << endl;
+        cout << string(60, '-') << endl;
+        cout << left << setw(30) << "Metric" << setw(15) << "Trie" << setw(15) << "Hash Table" << endl;
+        cout << string(60, '-') << endl;
+        cout << left << setw(30) << "Words found:" << setw(15) << found[0] << setw(15) << found[2] << endl;
+        cout << left << setw(30) << "Plain (μs per query):"
+             << setw(15) << fixed << setprecision(3) << micros[0] / (double)NUM_QUERIES
+             << setw(15) << micros[2] / (double)NUM_QUERIES << endl;
+        cout << left << setw(30) << "With Bloom (μs per query):"
+             << setw(15) << fixed << setprecision(3) << micros[1] / (double)NUM_QUERIES
+             << setw(15) << micros[3] / (double)NUM_QUERIES << endl;
+        cout << left << setw(30) << "Speedup:"
+             << setw(15) << fixed << setprecision(2) << micros[0] / (double)max(1LL, micros[1])
+             << setw(15) << micros[2] / (double)max(1LL, micros[3]) << endl;
+        cout << string(60, '-') << endl;
+        cout << "Bloom filter false positives: " << falsePositives << " of " << misses << " misses ("
+             << fixed << setprecision(3) << falsePositiveRate * 100 << "%)" << endl;
+        if (found[0] != found[1] || found[2] != found[3]) {
+            cout << "Warning: screened and plain lookups disagree" << endl;
+        }
+
+        ofstream csvFile("bloom_results.csv");
+        if (!csvFile.is_open()) {
+            cout << "Error: Could not create CSV file" << endl;
+            return;
+        }
+        csvFile << "Metric,Trie,Hash Table" << endl;
+        csvFile << "Miss Ratio (%)," << missPercent << "," << missPercent << endl;
+        csvFile << "Plain Lookup (microseconds)," << fixed << setprecision(3)
+                << micros[0] / (double)NUM_QUERIES << "," << micros[2] / (double)NUM_QUERIES << endl;
+        csvFile << "Bloom-Screened Lookup (microseconds)," << micros[1] / (double)NUM_QUERIES << ","
+                << micros[3] / (double)NUM_QUERIES << endl;
+        csvFile << "Measured False-Positive Rate," << fixed << setprecision(5) << falsePositiveRate << ","
+                << falsePositiveRate << endl;
+        csvFile.close();
+        cout << endl << "Results exported to 'bloom_results.csv'" << endl;
+    }
+
     void displayMemoryUsage() {
         if (!trieBuilt && !hashTableBuilt) {
             cout << "Error: Please build at least one data structure first." << endl;
@@ -330,15 +2367,53 @@ public:
         cout << string(60, '=') << endl;
 
         if (trieBuilt) {
-            trieMemory = estimateTrieMemory();
-            cout << "Trie: ~" << (trieMemory / 1024) << " KB (~" << (trieMemory / 1024 / 1024) << " MB)" << endl;
+            cout << "Trie (" << trieEngineName() << "): ~" << (trieMemory / 1024) << " KB (~"
+                 << (trieMemory / 1024 / 1024) << " MB, measured)" << endl;
+            if (trieEngine == LOUDS_TRIE) {
+                cout << "  - Nodes: " << loudsTrie->nodeCount() << endl;
+                cout << "  - Bits per node: " << fixed << setprecision(2) << loudsTrie->bitsPerNode()
+                     << " (" << loudsTrie->shapeBitsPerNode() << " without labels)" << endl;
+            } else if (trieEngine == DAWG_TRIE) {
+                cout << "  - States: " << dawg->stateCount() << " (a trie over the same words needs "
+                     << dawg->trieStateCount() << " nodes)" << endl;
+                cout << "  - Build peak: " << dawg->buildPeakStates() << " states held at once" << endl;
+                cout << "  - Transitions: " << dawg->transitionCount() << endl;
+                cout << "  - Bytes per word: " << fixed << setprecision(2)
+                     << (double)dawg->memoryBytes() / dawg->size() << endl;
+            } else if (trieEngine == RADIX_TRIE) {
+                cout << "  - Nodes: " << radixTrie->nodeCount() << endl;
+                cout << "  - Edge label arena: " << (radixTrie->labelBytes() / 1024) << " KB ("
+                     << (radixTrie->deadLabelBytes() / 1024) << " KB dead)" << endl;
+            } else {
+                cout << "  - Node layout: " << Trie::layoutName() << endl;
+                cout << "  - Nodes: " << trie->nodeCount() << endl;
+            }
+        }
+
+        if (doubleArrayTrie) {
+            size_t bytes = doubleArrayTrie->memoryBytes();
+            cout << "Double-array Trie (frozen): ~" << (bytes / 1024) << " KB (~" << (bytes / 1024 / 1024) << " MB)" << endl;
+            cout << "  - Cells: " << doubleArrayTrie->cellCount() << " (" << doubleArrayTrie->usedCells() << " used)" << endl;
         }
 
         if (hashTableBuilt) {
             hashMemory = estimateHashTableMemory();
-            cout << "Hash Table: ~" << (hashMemory / 1024) << " KB (~" << (hashMemory / 1024 / 1024) << " MB)" << endl;
-            cout << "  - Bucket count: " << hashTable->bucketCount() << endl;
-            cout << "  - Stored words: " << hashTable->size() << endl;
+            cout << "Hash Table (" << hashEngineName() << "): ~" << (hashMemory / 1024) << " KB (~" << (hashMemory / 1024 / 1024) << " MB)" << endl;
+            if (hashEngine == FLAT_HASH) {
+                cout << "  - Slot capacity: " << flatHashSet->capacity() << endl;
+                cout << "  - Stored words: " << flatHashSet->size() << endl;
+            } else if (hashEngine == ARENA_HASH) {
+                cout << "  - Bucket count: " << arenaHashTable->bucketCount() << endl;
+                cout << "  - Stored words: " << arenaHashTable->size() << endl;
+                cout << "  - Key arena: " << (arenaHashTable->arenaBytes() / 1024) << " KB" << endl;
+                displayChainStats(*arenaHashTable);
+            } else {
+                cout << "  - Bucket count: " << hashTable->bucketCount() << endl;
+                cout << "  - Stored words: " << hashTable->size() << endl;
+                cout << "  - Load factor: " << fixed << setprecision(2) << hashTable->loadFactor()
+                     << " (max " << hashTable->maxLoadFactor() << ")" << endl;
+                displayChainStats(*hashTable);
+            }
         }
 
         cout << string(60, '=') << endl;
@@ -357,6 +2432,26 @@ public:
         cout << "4. Run Benchmark (Compare Lookup Time)" << endl;
         cout << "5. Display Memory Usage" << endl;
         cout << "6. Exit" << endl;
+        cout << "----------------------------------------" << endl;
+        cout << "7. Hash Function Benchmark" << endl;
+        cout << "8. Batch Lookup Benchmark" << endl;
+        cout << "9. Build Frozen Dictionary (Perfect Hash)" << endl;
+        cout << "10. Concurrent Hash Table Benchmark" << endl;
+        cout << "11. Build Bloom Filter" << endl;
+        cout << "12. Miss-Heavy Benchmark (Bloom Filter)" << endl;
+        cout << "13. Trie Node Layout Benchmark" << endl;
+        cout << "14. Freeze Trie (Double-Array vs LOUDS)" << endl;
+        cout << "15. Autocomplete a Prefix (Top-k)" << endl;
+        cout << "16. Autocomplete Benchmark" << endl;
+        cout << "17. Browse Words by Prefix" << endl;
+        cout << "18. Fuzzy Search (Did You Mean)" << endl;
+        cout << "19. Fuzzy Search Benchmark" << endl;
+        cout << "20. Wildcard Pattern Match" << endl;
+        cout << "21. Wildcard Pattern Benchmark" << endl;
+        cout << "22. Concurrent Trie Benchmark (RCU)" << endl;
+        cout << "23. Trie Bulk Load Benchmark" << endl;
+        cout << "24. Dataset Loader Benchmark (mmap vs stream)" << endl;
+        cout << "25. Parallel Tokenizer Benchmark" << endl;
         cout << "========================================" << endl;
         cout << "Enter your choice: ";
     }
@@ -393,6 +2488,63 @@ public:
                 case 6:
                     cout << "Exiting program. Goodbye!" << endl;
                     return;
+                case 7:
+                    runHashPolicyBenchmark();
+                    break;
+                case 8:
+                    runBatchLookupBenchmark();
+                    break;
+                case 9:
+                    buildFrozenDictionary();
+                    break;
+                case 10:
+                    runConcurrentBenchmark();
+                    break;
+                case 11:
+                    buildBloomFilter();
+                    break;
+                case 12:
+                    runMissHeavyBenchmark();
+                    break;
+                case 13:
+                    runTrieLayoutBenchmark();
+                    break;
+                case 14:
+                    freezeTrie();
+                    break;
+                case 15:
+                    autocompleteWord();
+                    break;
+                case 16:
+                    runAutocompleteBenchmark();
+                    break;
+                case 17:
+                    browsePrefix();
+                    break;
+                case 18:
+                    fuzzySearchWord();
+                    break;
+                case 19:
+                    runFuzzyBenchmark();
+                    break;
+                case 20:
+                    matchPattern();
+                    break;
+                case 21:
+                    runPatternBenchmark();
+                    break;
+                case 22:
+                    runConcurrentTrieBenchmark();
+                    break;
+                case 23:
+                    runBulkLoadBenchmark();
+                    break;
+                case 24:
+                    runLoaderBenchmark();
+                    break;
+                case 25:
+                    runTokenizerBenchmark();
+                    break;
                 default:
                     cout << "Invalid choice. Please try again." << endl;
             }
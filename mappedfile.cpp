@@ -0,0 +1,95 @@
+#include "mappedfile.h"
+#include <stdexcept>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const string& path) : data_(nullptr), size_(0), file_(nullptr), mapping_(nullptr) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw runtime_error("MappedFile: cannot open '" + path + "'");
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw runtime_error("MappedFile: cannot read the size of '" + path + "'");
+    }
+    file_ = file;
+    size_ = (size_t)fileSize.QuadPart;
+
+    // Windows cannot map an empty file; it simply has no bytes.
+    if (size_ == 0) {
+        return;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        throw runtime_error("MappedFile: cannot map '" + path + "'");
+    }
+    mapping_ = mapping;
+    data_ = static_cast<const char*>(view);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+    }
+    if (file_) {
+        CloseHandle(file_);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const string& path) : data_(nullptr), size_(0) {
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw runtime_error("MappedFile: cannot open '" + path + "'");
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+        close(descriptor);
+        throw runtime_error("MappedFile: cannot read the size of '" + path + "'");
+    }
+    size_ = (size_t)status.st_size;
+
+    // mmap rejects a zero length; an empty file simply has no bytes.
+    if (size_ > 0) {
+        void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapped == MAP_FAILED) {
+            close(descriptor);
+            throw runtime_error("MappedFile: cannot map '" + path + "'");
+        }
+        madvise(mapped, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(mapped);
+    }
+    // The mapping keeps the file alive on its own.
+    close(descriptor);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+
+// A whole file mapped read-only into memory. The bytes are paged in by the
+// OS on first touch and never copied into the heap. Uses mmap on POSIX
+// systems and a file mapping object on Windows.
+class MappedFile {
+    public:
+    // Throws std::runtime_error if the file cannot be opened or mapped.
+    explicit MappedFile(const string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const {
+        return data_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    string_view view() const {
+        return string_view(data_, size_);
+    }
+
+    private:
+    const char* data_;
+    size_t size_;
+#if defined(_WIN32)
+    void* file_;
+    void* mapping_;
+#endif
+};
+
+#endif
@@ -0,0 +1,97 @@
+#include "processmemory.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#else
+#include <fstream>
+#include <string>
+#endif
+
+using namespace std;
+
+#if defined(_WIN32)
+
+size_t peakResidentBytes() {
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+}
+
+size_t currentResidentBytes() {
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.WorkingSetSize;
+}
+
+bool resetPeakResident() {
+    return false;
+}
+
+#elif defined(__APPLE__)
+
+size_t peakResidentBytes() {
+    // ru_maxrss is in bytes on macOS.
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return (size_t)usage.ru_maxrss;
+}
+
+size_t currentResidentBytes() {
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return (size_t)info.resident_size;
+}
+
+bool resetPeakResident() {
+    return false;
+}
+
+#else
+
+namespace {
+
+// A "Vm...:   1234 kB" line of /proc/self/status, in bytes.
+size_t statusField(const string& name) {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, name.size(), name) == 0 && line.size() > name.size() && line[name.size()] == ':') {
+            return (size_t)stoull(line.substr(name.size() + 1)) * 1024;
+        }
+    }
+    return 0;
+}
+
+}
+
+size_t peakResidentBytes() {
+    return statusField("VmHWM");
+}
+
+size_t currentResidentBytes() {
+    return statusField("VmRSS");
+}
+
+bool resetPeakResident() {
+    // Writing 5 to clear_refs resets the peak RSS (Linux 4.0 and later).
+    ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.flush();
+    return (bool)clearRefs;
+}
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef PROCESSMEMORY_H
+#define PROCESSMEMORY_H
+
+#include <cstddef>
+
+using std::size_t;
+
+// Process memory as the OS sees it, including mapped file pages, which the
+// heap counters in main.cpp cannot see.
+
+// Largest resident set this process has had, in bytes (0 if unknown).
+size_t peakResidentBytes();
+
+// Resident set right now, in bytes (0 if unknown).
+size_t currentResidentBytes();
+
+// Lowers the peak to the current resident set, where the OS allows it
+// (Linux). Returns false where the peak can only grow.
+bool resetPeakResident();
+
+#endif
@@ -0,0 +1,218 @@
+#include "radixtrie.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+RadixTrie::RadixTrie() : words_(0), deadLabelBytes_(0) {
+    nodes_.push_back(Node());
+}
+
+uint32_t RadixTrie::newNode(uint32_t labelOffset, uint32_t labelLength, bool endOfWord) {
+    uint32_t index;
+    if (!freeNodes_.empty()) {
+        index = freeNodes_.back();
+        freeNodes_.pop_back();
+    } else {
+        index = (uint32_t)nodes_.size();
+        nodes_.push_back(Node());
+    }
+    Node& node = nodes_[index];
+    node.labelOffset = labelOffset;
+    node.labelLength = labelLength;
+    node.endOfWord = endOfWord;
+    return index;
+}
+
+void RadixTrie::releaseNode(uint32_t index) {
+    nodes_[index] = Node();
+    freeNodes_.push_back(index);
+}
+
+uint32_t RadixTrie::appendLabel(string_view label) {
+    if (label.size() > UINT32_MAX - labels_.size()) {
+        throw std::length_error("RadixTrie: label arena past 4 GiB");
+    }
+    uint32_t offset = (uint32_t)labels_.size();
+    labels_.insert(labels_.end(), label.begin(), label.end());
+    return offset;
+}
+
+size_t RadixTrie::commonPrefix(const Node& node, string_view rest) const {
+    const char* label = labels_.data() + node.labelOffset;
+    size_t limit = min((size_t)node.labelLength, rest.size());
+    size_t length = 0;
+    while (length < limit && label[length] == rest[length]) {
+        length++;
+    }
+    return length;
+}
+
+void RadixTrie::insert(string_view word) {
+    uint32_t node = 0;
+    size_t position = 0;
+
+    while (position < word.size()) {
+        string_view rest = word.substr(position);
+        uint32_t child = nodes_[node].children.find(rest[0]);
+        if (!child) {
+            uint32_t leaf = newNode(appendLabel(rest), (uint32_t)rest.size(), true);
+            nodes_[node].children.add(rest[0], leaf);
+            words_++;
+            return;
+        }
+
+        size_t common = commonPrefix(nodes_[child], rest);
+        if (common < nodes_[child].labelLength) {
+            // Split the edge: a new node takes the shared part of the
+            // label, and the old child keeps the tail under it.
+            uint32_t middle = newNode(nodes_[child].labelOffset, (uint32_t)common, false);
+            nodes_[child].labelOffset += (uint32_t)common;
+            nodes_[child].labelLength -= (uint32_t)common;
+            nodes_[middle].children.add(labels_[nodes_[child].labelOffset], child);
+            nodes_[node].children.erase(rest[0]);
+            nodes_[node].children.add(rest[0], middle);
+            child = middle;
+        }
+
+        node = child;
+        position += common;
+    }
+
+    if (!nodes_[node].endOfWord) {
+        nodes_[node].endOfWord = true;
+        words_++;
+    }
+}
+
+void RadixTrie::mergeWithOnlyChild(uint32_t index) {
+    uint32_t child = 0;
+    nodes_[index].children.forEach([&child](char, uint32_t link) {
+        child = link;
+    });
+
+    // Undoing a split finds the child's label right after the node's, so
+    // the merged label is already in place.
+    if (nodes_[index].labelOffset + nodes_[index].labelLength != nodes_[child].labelOffset) {
+        string merged(labels_.data() + nodes_[index].labelOffset, nodes_[index].labelLength);
+        merged.append(labels_.data() + nodes_[child].labelOffset, nodes_[child].labelLength);
+        deadLabelBytes_ += merged.size();
+        nodes_[index].labelOffset = appendLabel(merged);
+    }
+
+    Node& node = nodes_[index];
+    node.labelLength += nodes_[child].labelLength;
+    node.endOfWord = nodes_[child].endOfWord;
+    node.children = std::move(nodes_[child].children);
+    releaseNode(child);
+}
+
+void RadixTrie::remove(string_view word) {
+    uint32_t parent = 0;
+    uint32_t node = 0;
+    size_t position = 0;
+
+    while (position < word.size()) {
+        uint32_t child = nodes_[node].children.find(word[position]);
+        if (!child) return;
+        const Node& next = nodes_[child];
+        if (word.size() - position < next.labelLength
+            || memcmp(labels_.data() + next.labelOffset, word.data() + position, next.labelLength) != 0) {
+            return;
+        }
+        parent = node;
+        node = child;
+        position += next.labelLength;
+    }
+
+    if (!nodes_[node].endOfWord) return;
+    nodes_[node].endOfWord = false;
+    words_--;
+    if (node == 0) return;
+
+    // Keep every non-root node either a word end or a branch point.
+    size_t childCount = nodes_[node].children.size();
+    if (childCount == 0) {
+        nodes_[parent].children.erase(labels_[nodes_[node].labelOffset]);
+        deadLabelBytes_ += nodes_[node].labelLength;
+        releaseNode(node);
+        if (parent != 0 && !nodes_[parent].endOfWord && nodes_[parent].children.size() == 1) {
+            mergeWithOnlyChild(parent);
+        }
+    } else if (childCount == 1) {
+        mergeWithOnlyChild(node);
+    }
+
+    if (deadLabelBytes_ > labels_.size() / 2) {
+        compactLabels();
+    }
+}
+
+void RadixTrie::compactLabels() {
+    // Live labels never overlap, so copying each one once keeps them all.
+    vector<char> live;
+    live.reserve(labels_.size() - deadLabelBytes_);
+    for (Node& node : nodes_) {
+        uint32_t offset = (uint32_t)live.size();
+        live.insert(live.end(), labels_.begin() + node.labelOffset,
+                    labels_.begin() + node.labelOffset + node.labelLength);
+        node.labelOffset = offset;
+    }
+    labels_.swap(live);
+    deadLabelBytes_ = 0;
+}
+
+bool RadixTrie::search(string_view word) const {
+    uint32_t node = 0;
+    size_t position = 0;
+
+    while (position < word.size()) {
+        uint32_t child = nodes_[node].children.find(word[position]);
+        if (!child) return false;
+        const Node& next = nodes_[child];
+        if (word.size() - position < next.labelLength
+            || memcmp(labels_.data() + next.labelOffset, word.data() + position, next.labelLength) != 0) {
+            return false;
+        }
+        node = child;
+        position += next.labelLength;
+    }
+    return nodes_[node].endOfWord;
+}
+
+bool RadixTrie::startsWith(string_view prefix) const {
+    uint32_t node = 0;
+    size_t position = 0;
+
+    while (position < prefix.size()) {
+        uint32_t child = nodes_[node].children.find(prefix[position]);
+        if (!child) return false;
+        const Node& next = nodes_[child];
+        // The prefix may end part way along this edge.
+        size_t length = min((size_t)next.labelLength, prefix.size() - position);
+        if (memcmp(labels_.data() + next.labelOffset, prefix.data() + position, length) != 0) {
+            return false;
+        }
+        node = child;
+        position += length;
+    }
+    return true;
+}
+
+size_t RadixTrie::pathLength(string_view word) const {
+    uint32_t node = 0;
+    size_t position = 0;
+    size_t steps = 0;
+
+    while (position < word.size()) {
+        uint32_t child = nodes_[node].children.find(word[position]);
+        if (!child) break;
+        steps++;
+        size_t common = commonPrefix(nodes_[child], word.substr(position));
+        if (common < nodes_[child].labelLength) break;
+        node = child;
+        position += common;
+    }
+    return steps;
+}
@@ -0,0 +1,81 @@
+#ifndef RADIXTRIE_H
+#define RADIXTRIE_H
+
+#include "triechildren.h"
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using std::size_t;
+using std::string_view;
+using std::vector;
+
+// Path-compressed (Patricia) trie. Every edge carries a label of one or
+// more bytes, so a chain of single-child nodes collapses into one node and
+// a lookup steps once per branch point instead of once per character.
+// Labels are {offset, length} slices of one shared byte arena. Nodes live
+// in one vector and refer to each other by 32-bit index, with index 0 as
+// the root and as the null link, the same scheme as BasicTrie.
+class RadixTrie {
+    public:
+    RadixTrie();
+
+    void insert(string_view word);
+    void remove(string_view word);
+    bool search(string_view word) const;
+    bool startsWith(string_view prefix) const;
+
+    // Number of child links a lookup for word follows.
+    size_t pathLength(string_view word) const;
+
+    size_t size() const {
+        return words_;
+    }
+
+    // Nodes currently in the tree, including the root.
+    size_t nodeCount() const {
+        return nodes_.size() - freeNodes_.size();
+    }
+
+    size_t labelBytes() const {
+        return labels_.size();
+    }
+
+    // Arena bytes no longer referenced by any label. Splits reuse the
+    // existing bytes, and so does a merge that undoes a split; any other
+    // merge appends a new label. remove() compacts the arena once more
+    // than half of it is dead.
+    size_t deadLabelBytes() const {
+        return deadLabelBytes_;
+    }
+
+    static const char* layoutName() {
+        return "radix";
+    }
+
+    private:
+    struct Node {
+        uint32_t labelOffset;
+        uint32_t labelLength;
+        bool endOfWord;
+        SortedArrayChildren<uint32_t> children;
+
+        Node() : labelOffset(0), labelLength(0), endOfWord(false) {}
+    };
+
+    vector<Node> nodes_;
+    vector<uint32_t> freeNodes_;
+    vector<char> labels_;
+    size_t words_;
+    size_t deadLabelBytes_;
+
+    uint32_t newNode(uint32_t labelOffset, uint32_t labelLength, bool endOfWord);
+    void releaseNode(uint32_t index);
+    uint32_t appendLabel(string_view label);
+    size_t commonPrefix(const Node& node, string_view rest) const;
+    void mergeWithOnlyChild(uint32_t index);
+    void compactLabels();
+};
+
+#endif
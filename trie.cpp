@@ -1,72 +1,600 @@
 #include "trie.h"
+#include <algorithm>
+#include <exception>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 
-Trie::Trie() {
-    root = new TrieNode();
+template <template <typename> class Children>
+BasicTrie<Children>::BasicTrie() : nodesUsed(0), nodes(1) {
+    allocateNode();
 
 }
 
-Trie::~Trie() {
-    clear(root);
+template <template <typename> class Children>
+BasicTrie<Children>::~BasicTrie() {
+    // Freed nodes stay constructed (empty) on the free list, so every slot
+    // below nodesUsed is a live object. Layouts with nothing to destroy
+    // skip the sweep entirely.
+    if (!std::is_trivially_destructible<Node>::value) {
+        for (uint32_t i = 0; i < nodesUsed; i++) {
+            nodeAt(i).~Node();
+        }
+    }
+    for (Node* slab : slabs) {
+        ::operator delete(slab);
+    }
+}
+
+template <template <typename> class Children>
+uint32_t BasicTrie<Children>::allocateNode() {
+    if (!freeNodes.empty()) {
+        uint32_t index = freeNodes.back();
+        freeNodes.pop_back();
+        Node& node = nodeAt(index);
+        node.endOfWord = false;
+        node.weight = 0;
+        node.bestWeight = 0;
+        node.wordsBelow = 0;
+        return index;
+    }
+
+    if (nodesUsed == UINT32_MAX)
+        throw std::length_error("Trie: node index space exhausted");
+    if ((nodesUsed & (SLAB_NODES - 1)) == 0) {
+        slabs.push_back(static_cast<Node*>(::operator new(SLAB_NODES * sizeof(Node))));
+    }
+    uint32_t index = nodesUsed++;
+    new (&nodeAt(index)) Node();
+    return index;
 }
 
-void Trie::clear(TrieNode* node) {
-    if (!node) return;
-    for (auto& pair : node->children) {
-        clear(pair.second);
+template <template <typename> class Children>
+void BasicTrie<Children>::padToSlabBoundary() {
+    // Every slot below nodesUsed must hold a constructed node, so the rest
+    // of a partly used slab is filled with empty nodes on the free list.
+    while (nodesUsed & (SLAB_NODES - 1)) {
+        new (&nodeAt(nodesUsed)) Node();
+        freeNodes.push_back(nodesUsed++);
     }
-    delete node;
 }
 
-void Trie::insert(const std::string& word) {
-    TrieNode* node = root;
+template <template <typename> class Children>
+void BasicTrie<Children>::refreshBestWeight(Node& node) {
+    uint32_t best = node.endOfWord ? node.weight : 0;
+    node.children.forEach([&](char, uint32_t child) {
+        best = std::max(best, nodeAt(child).bestWeight);
+    });
+    node.bestWeight = best;
+}
+
+template <template <typename> class Children>
+void BasicTrie<Children>::requireAccepted(std::string_view word) {
     for (char c : word) {
-        if (!node->children[c])
-            node->children[c] = new TrieNode();
-        node = node->children[c];
+        if (!Children<uint32_t>::accepts(c))
+            throw std::invalid_argument("Trie: character not supported by the " + std::string(layoutName()) + " layout");
+    }
+}
+
+template <template <typename> class Children>
+void BasicTrie<Children>::insert(std::string_view word, uint32_t weight) {
+    requireAccepted(word);
+
+    // Subtree counts are raised on the way down, assuming the word is new,
+    // and dropped again below if it was already there.
+    uint32_t node = 0;
+    nodeAt(node).bestWeight = std::max(nodeAt(node).bestWeight, weight);
+    nodeAt(node).wordsBelow++;
+    for (char c : word) {
+        uint32_t child = nodeAt(node).children.find(c);
+        if (!child) {
+            child = allocateNode();
+            nodeAt(node).children.add(c, child);
+            nodes++;
+        }
+        node = child;
+        nodeAt(node).bestWeight = std::max(nodeAt(node).bestWeight, weight);
+        nodeAt(node).wordsBelow++;
+    }
+
+    Node& last = nodeAt(node);
+    bool existed = last.endOfWord;
+    bool lowered = existed && last.weight > weight;
+    last.endOfWord = true;
+    last.weight = weight;
+    if (!existed)
+        return;
+
+    // A lowered weight may have been some ancestor's maximum; recompute
+    // the path bottom-up.
+    std::vector<uint32_t> path(1, 0);
+    for (char c : word)
+        path.push_back(nodeAt(path.back()).children.find(c));
+    for (size_t i = path.size(); i-- > 0;) {
+        nodeAt(path[i]).wordsBelow--;
+        if (lowered)
+            refreshBestWeight(nodeAt(path[i]));
+    }
+}
+
+template <template <typename> class Children>
+void BasicTrie<Children>::buildParallel(const std::vector<std::string_view>& words, const std::vector<uint32_t>& weights,
+                                        unsigned threadCount) {
+    if (nodes != 1 || nodeAt(0).endOfWord)
+        throw std::logic_error("Trie: buildParallel needs an empty trie");
+    for (std::string_view word : words)
+        requireAccepted(word);
+    auto weightOf = [&](size_t i) { return weights.empty() ? 1u : weights[i]; };
+
+    std::vector<size_t> groupSize(256, 0);
+    std::vector<unsigned> groups;
+    for (std::string_view word : words) {
+        if (!word.empty() && groupSize[(unsigned char)word[0]]++ == 0)
+            groups.push_back((unsigned char)word[0]);
+    }
+    std::sort(groups.begin(), groups.end(), [&](unsigned a, unsigned b) { return groupSize[a] > groupSize[b]; });
+    threadCount = std::max(1u, std::min(threadCount, (unsigned)groups.size()));
+
+    std::vector<size_t> load(threadCount, 0);
+    std::vector<unsigned> owner(256, 0);
+    for (unsigned group : groups) {
+        unsigned lightest = (unsigned)(std::min_element(load.begin(), load.end()) - load.begin());
+        owner[group] = lightest;
+        load[lightest] += groupSize[group];
+    }
+    std::vector<std::vector<size_t>> assigned(threadCount);
+    for (size_t i = 0; i < words.size(); i++) {
+        if (words[i].empty())
+            insert(words[i], weightOf(i));
+        else
+            assigned[owner[(unsigned char)words[i][0]]].push_back(i);
+    }
+
+    std::vector<std::unique_ptr<BasicTrie>> parts(threadCount);
+    std::vector<std::exception_ptr> failures(threadCount);
+    auto runWorkers = [&](auto work) {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threadCount; t++) {
+            workers.push_back(std::thread([&, t]() {
+                try {
+                    work(t);
+                } catch (...) {
+                    failures[t] = std::current_exception();
+                }
+            }));
+        }
+        for (std::thread& worker : workers)
+            worker.join();
+        for (std::exception_ptr& failure : failures) {
+            if (failure)
+                std::rethrow_exception(failure);
+        }
+    };
+
+    runWorkers([&](unsigned t) {
+        parts[t].reset(new BasicTrie());
+        for (size_t i : assigned[t])
+            parts[t]->insert(words[i], weightOf(i));
+    });
+
+    // Each part starts on a fresh slab here, so its indices shift by a
+    // whole number of slabs and nodeAt() keeps finding the same objects.
+    std::vector<uint32_t> bases(threadCount);
+    uint64_t cursor = (nodesUsed + SLAB_NODES - 1) & ~(uint64_t)(SLAB_NODES - 1);
+    for (unsigned t = 0; t < threadCount; t++) {
+        bases[t] = (uint32_t)cursor;
+        cursor = (cursor + parts[t]->nodesUsed + SLAB_NODES - 1) & ~(uint64_t)(SLAB_NODES - 1);
+        if (cursor > UINT32_MAX)
+            throw std::length_error("Trie: node index space exhausted");
+    }
+
+    runWorkers([&](unsigned t) {
+        BasicTrie& part = *parts[t];
+        uint32_t base = bases[t];
+        for (uint32_t i = 0; i < part.nodesUsed; i++)
+            part.nodeAt(i).children.remap([base](uint32_t link) { return link + base; });
+        for (uint32_t& index : part.freeNodes)
+            index += base;
+    });
+
+    Node& root = nodeAt(0);
+    for (unsigned t = 0; t < threadCount; t++) {
+        BasicTrie& part = *parts[t];
+        padToSlabBoundary();
+        slabs.insert(slabs.end(), part.slabs.begin(), part.slabs.end());
+        freeNodes.insert(freeNodes.end(), part.freeNodes.begin(), part.freeNodes.end());
+        nodesUsed = bases[t] + part.nodesUsed;
+        nodes += part.nodes - 1;
+
+        // Hang the part's top-level children under the root, then empty the
+        // part's own root and keep it as a free node.
+        Node& partRoot = nodeAt(bases[t]);
+        std::string keys;
+        partRoot.children.forEach([&](char c, uint32_t child) {
+            root.children.add(c, child);
+            keys.push_back(c);
+        });
+        for (char c : keys)
+            partRoot.children.erase(c);
+        root.wordsBelow += partRoot.wordsBelow;
+        root.bestWeight = std::max(root.bestWeight, partRoot.bestWeight);
+        freeNodes.push_back(bases[t]);
+
+        // The slabs belong to this trie now.
+        part.slabs.clear();
+        part.freeNodes.clear();
+        part.nodesUsed = 0;
     }
-    node->endOfWord = true;
 }
 
-bool Trie::removeHelper(TrieNode* node, const std::string& word, int depth) {
-    if (!node) return false;
+template <template <typename> class Children>
+void BasicTrie<Children>::bulkLoadSorted(const std::vector<std::string_view>& words, const std::vector<uint32_t>& weights) {
+    if (nodes != 1 || nodeAt(0).endOfWord)
+        throw std::logic_error("Trie: bulkLoadSorted needs an empty trie");
+    for (std::string_view word : words)
+        requireAccepted(word);
+
+    std::vector<size_t> order;
+    if (!std::is_sorted(words.begin(), words.end())) {
+        order.resize(words.size());
+        for (size_t i = 0; i < order.size(); i++)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return words[a] < words[b]; });
+    }
+
+    // path[d] is the node at depth d on the previous word. A node that
+    // leaves the stack has its whole subtree built, so only then is its
+    // own word counted and its totals added to its parent.
+    std::vector<uint32_t> path(1, 0);
+    auto finish = [](Node& node) {
+        if (node.endOfWord) {
+            node.wordsBelow++;
+            node.bestWeight = std::max(node.bestWeight, node.weight);
+        }
+    };
+    auto popTo = [&](size_t depth) {
+        while (path.size() > depth + 1) {
+            Node& done = nodeAt(path.back());
+            finish(done);
+            path.pop_back();
+            Node& parent = nodeAt(path.back());
+            parent.wordsBelow += done.wordsBelow;
+            parent.bestWeight = std::max(parent.bestWeight, done.bestWeight);
+        }
+    };
+
+    std::string_view previous;
+    for (size_t n = 0; n < words.size(); n++) {
+        size_t i = order.empty() ? n : order[n];
+        std::string_view word = words[i];
+
+        size_t common = 0;
+        while (common < word.size() && common < previous.size() && word[common] == previous[common])
+            common++;
+        popTo(common);
+
+        // Sorted input means each new child's key is the largest so far
+        // under its parent.
+        for (size_t depth = common; depth < word.size(); depth++) {
+            uint32_t child = allocateNode();
+            nodeAt(path.back()).children.add(word[depth], child);
+            nodes++;
+            path.push_back(child);
+        }
+
+        // A repeated word only takes the later weight.
+        Node& last = nodeAt(path.back());
+        last.endOfWord = true;
+        last.weight = weights.empty() ? 1 : weights[i];
+        previous = word;
+    }
+
+    popTo(0);
+    finish(nodeAt(0));
+}
+
+template <template <typename> class Children>
+bool BasicTrie<Children>::removeHelper(uint32_t node, std::string_view word, int depth) {
+    Node& current = nodeAt(node);
+    current.wordsBelow--;
 
     if (depth == (int)word.size()) {
-        if (!node->endOfWord) return false;
-        node->endOfWord = false;
-        return node->children.empty();
+        current.endOfWord = false;
+        current.weight = 0;
+        refreshBestWeight(current);
+        return current.children.empty();
     }
     char c = word[depth];
-    if (!node->children.count(c)) return false;
+    uint32_t child = current.children.find(c);
 
-    bool deletable = removeHelper(node->children[c], word, depth + 1);
+    bool deletable = removeHelper(child, word, depth + 1);
     if (deletable) {
-        delete node->children[c];
-        node->children.erase(c);
-        return node->children.empty() && !node->endOfWord;
+        freeNodes.push_back(child);
+        current.children.erase(c);
+        nodes--;
     }
-    return false;
+    refreshBestWeight(current);
+    return deletable && current.children.empty() && !current.endOfWord;
 }
 
-bool Trie::search(const std::string& word) {
-    TrieNode* node = root;
+template <template <typename> class Children>
+const typename BasicTrie<Children>::Node* BasicTrie<Children>::findNode(std::string_view word) const {
+    const Node* node = &nodeAt(0);
     for (char c : word) {
-        if (!node->children.count(c))
-            return false;
-        node = node->children[c];
+        uint32_t child = node->children.find(c);
+        if (!child)
+            return nullptr;
+        node = &nodeAt(child);
     }
-    return node->endOfWord;
+    return node;
 }
-void Trie::remove(const std::string& word) {
-    removeHelper(root,word, 0);
+
+template <template <typename> class Children>
+bool BasicTrie<Children>::search(std::string_view word) const {
+    const Node* node = findNode(word);
+    return node && node->endOfWord;
 }
 
-bool Trie::startsWith(const std::string &prefix) {
-    TrieNode* node = root;
+template <template <typename> class Children>
+void BasicTrie<Children>::remove(std::string_view word) {
+    // Checking first lets removeHelper drop the subtree counts on the way
+    // down, knowing the word is there.
+    if (search(word))
+        removeHelper(0, word, 0);
+}
+
+template <template <typename> class Children>
+bool BasicTrie<Children>::startsWith(std::string_view prefix) const {
+    return findNode(prefix) != nullptr;
+}
+
+template <template <typename> class Children>
+std::vector<Completion> BasicTrie<Children>::autocomplete(std::string_view prefix, size_t k) const {
+    std::vector<Completion> results;
+    uint32_t start = 0;
     for (char c : prefix) {
-        if (!node->children.count(c))
-            return false;
-        node = node->children[c];
+        start = nodeAt(start).children.find(c);
+        if (!start)
+            return results;
+    }
+
+    // A candidate is either a finished word or a whole subtree ranked by
+    // its best weight. No word in a subtree outranks the subtree itself,
+    // so words leave the queue in final order.
+    struct Candidate {
+        uint32_t weight;
+        bool isWord;
+        uint32_t node;
+        std::string text;
+    };
+    auto ranksBelow = [](const Candidate& a, const Candidate& b) {
+        if (a.weight != b.weight)
+            return a.weight < b.weight;
+        return a.text > b.text;
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(ranksBelow)> frontier(ranksBelow);
+    frontier.push(Candidate{nodeAt(start).bestWeight, false, start, std::string(prefix)});
+
+    while (!frontier.empty() && results.size() < k) {
+        Candidate top = frontier.top();
+        frontier.pop();
+        if (top.isWord) {
+            results.push_back(Completion{top.text, top.weight});
+            continue;
+        }
+
+        const Node& node = nodeAt(top.node);
+        if (node.endOfWord)
+            frontier.push(Candidate{node.weight, true, top.node, top.text});
+        node.children.forEach([&](char c, uint32_t child) {
+            frontier.push(Candidate{nodeAt(child).bestWeight, false, child, top.text + c});
+        });
     }
-    return true;
+    return results;
+}
+
+template <template <typename> class Children>
+void BasicTrie<Children>::fuzzyHelper(uint32_t node, std::string_view word, size_t maxEdits, std::vector<size_t>& rows,
+                                      std::string& prefix, std::vector<FuzzyMatch>& matches) const {
+    // Row d (d = prefix.size()) holds the edit distance from prefix to
+    // every prefix of word, and sits at rows[d * width].
+    size_t width = word.size() + 1;
+    size_t depth = prefix.size();
+    if (nodeAt(node).endOfWord && rows[depth * width + word.size()] <= maxEdits)
+        matches.push_back(FuzzyMatch{prefix, rows[depth * width + word.size()]});
+
+    if (rows.size() < (depth + 2) * width)
+        rows.resize((depth + 2) * width);
+    nodeAt(node).children.forEach([&](char c, uint32_t child) {
+        const size_t* above = &rows[depth * width];
+        size_t* row = &rows[(depth + 1) * width];
+        row[0] = above[0] + 1;
+        size_t best = row[0];
+        for (size_t i = 1; i < width; i++) {
+            size_t substitute = above[i - 1] + (word[i - 1] == c ? 0 : 1);
+            row[i] = std::min(std::min(row[i - 1], above[i]) + 1, substitute);
+            best = std::min(best, row[i]);
+        }
+        if (best > maxEdits)
+            return;
+
+        prefix.push_back(c);
+        fuzzyHelper(child, word, maxEdits, rows, prefix, matches);
+        prefix.pop_back();
+    });
+}
+
+template <template <typename> class Children>
+std::vector<FuzzyMatch> BasicTrie<Children>::fuzzySearch(std::string_view word, size_t maxEdits) const {
+    std::vector<size_t> rows(word.size() + 1);
+    for (size_t i = 0; i <= word.size(); i++)
+        rows[i] = i;
+    std::string prefix;
+    std::vector<FuzzyMatch> matches;
+    fuzzyHelper(0, word, maxEdits, rows, prefix, matches);
+
+    std::sort(matches.begin(), matches.end(), [](const FuzzyMatch& a, const FuzzyMatch& b) {
+        return a.distance != b.distance ? a.distance < b.distance : a.word < b.word;
+    });
+    return matches;
+}
+
+template <template <typename> class Children>
+void BasicTrie<Children>::matchHelper(uint32_t node, std::string_view pattern, std::vector<size_t>& positions,
+                                      size_t begin, std::vector<uint32_t>& marks, uint32_t& stamp,
+                                      std::string& prefix, std::vector<std::string>& matches) const {
+    // positions[begin, end) is this node's set; the children's sets are
+    // built after it in the same buffer.
+    size_t end = positions.size();
+    for (size_t i = begin; i < end; i++) {
+        if (positions[i] == pattern.size() && nodeAt(node).endOfWord) {
+            matches.push_back(prefix);
+            break;
+        }
+    }
+
+    nodeAt(node).children.forEach([&](char c, uint32_t child) {
+        // Adds position p and, since '*' may match nothing, every position
+        // reachable from it by skipping stars; marks drop repeats.
+        stamp++;
+        auto addClosure = [&](size_t p) {
+            while (true) {
+                if (marks[p] == stamp)
+                    return;
+                marks[p] = stamp;
+                positions.push_back(p);
+                if (p == pattern.size() || pattern[p] != '*')
+                    return;
+                p++;
+            }
+        };
+        for (size_t i = begin; i < end; i++) {
+            size_t p = positions[i];
+            if (p == pattern.size())
+                continue;
+            if (pattern[p] == '*')
+                addClosure(p);
+            else if (pattern[p] == '?' || pattern[p] == c)
+                addClosure(p + 1);
+        }
+
+        if (positions.size() > end) {
+            prefix.push_back(c);
+            matchHelper(child, pattern, positions, end, marks, stamp, prefix, matches);
+            prefix.pop_back();
+        }
+        positions.resize(end);
+    });
+}
+
+template <template <typename> class Children>
+std::vector<std::string> BasicTrie<Children>::match(std::string_view pattern) const {
+    std::vector<size_t> positions;
+    std::vector<uint32_t> marks(pattern.size() + 1, 0);
+    uint32_t stamp = 1;
+    for (size_t p = 0; ; p++) {
+        positions.push_back(p);
+        if (p == pattern.size() || pattern[p] != '*')
+            break;
+    }
+
+    std::string prefix;
+    std::vector<std::string> matches;
+    matchHelper(0, pattern, positions, 0, marks, stamp, prefix, matches);
+    return matches;
 }
+
+template <template <typename> class Children>
+BasicTrie<Children>::PrefixIterator::PrefixIterator(const BasicTrie* trie, uint32_t start, std::string_view prefix)
+    : trie(trie), buffer(prefix) {
+    stack.push_back(Frame{start, -1});
+    if (!trie->nodeAt(start).endOfWord)
+        ++*this;
+}
+
+template <template <typename> class Children>
+typename BasicTrie<Children>::PrefixIterator& BasicTrie<Children>::PrefixIterator::operator++() {
+    // Preorder walk: take the next child of the deepest node, or back up
+    // when it has none left, until a node that ends a word is entered.
+    while (!stack.empty()) {
+        Frame& top = stack.back();
+        char key;
+        uint32_t child = trie->nodeAt(top.node).children.nextAfter(top.lastKey, key);
+        if (child) {
+            top.lastKey = (unsigned char)key;
+            buffer.push_back(key);
+            stack.push_back(Frame{child, -1});
+            if (trie->nodeAt(child).endOfWord)
+                return *this;
+        } else {
+            stack.pop_back();
+            if (!stack.empty())
+                buffer.pop_back();
+        }
+    }
+    return *this;
+}
+
+template <template <typename> class Children>
+typename BasicTrie<Children>::PrefixRange BasicTrie<Children>::withPrefix(std::string_view prefix) const {
+    uint32_t start = 0;
+    for (char c : prefix) {
+        start = nodeAt(start).children.find(c);
+        if (!start)
+            return PrefixRange(PrefixIterator());
+    }
+    return PrefixRange(PrefixIterator(this, start, prefix));
+}
+
+template <template <typename> class Children>
+size_t BasicTrie<Children>::countWithPrefix(std::string_view prefix) const {
+    const Node* node = findNode(prefix);
+    return node ? node->wordsBelow : 0;
+}
+
+template <template <typename> class Children>
+size_t BasicTrie<Children>::pathLength(std::string_view word) const {
+    const Node* node = &nodeAt(0);
+    size_t steps = 0;
+    for (char c : word) {
+        uint32_t child = node->children.find(c);
+        if (!child)
+            break;
+        node = &nodeAt(child);
+        steps++;
+    }
+    return steps;
+}
+
+template <template <typename> class Children>
+void BasicTrie<Children>::collectWords(uint32_t node, std::string& prefix, std::vector<std::string>& words) const {
+    if (nodeAt(node).endOfWord)
+        words.push_back(prefix);
+    nodeAt(node).children.forEach([&](char c, uint32_t child) {
+        prefix.push_back(c);
+        collectWords(child, prefix, words);
+        prefix.pop_back();
+    });
+}
+
+template <template <typename> class Children>
+std::vector<std::string> BasicTrie<Children>::words() const {
+    std::vector<std::string> result;
+    std::string prefix;
+    collectWords(0, prefix, result);
+    return result;
+}
+
+template <template <typename> class Children>
+DoubleArrayTrie BasicTrie<Children>::freeze() const {
+    return DoubleArrayTrie(words());
+}
+
+template class BasicTrie<MapChildren>;
+template class BasicTrie<SortedArrayChildren>;
+template class BasicTrie<DirectChildren>;
+template class BasicTrie<BitmapChildren>;
@@ -1,32 +1,230 @@
 #ifndef TRIE_H
 #define TRIE_H
 
-#include <unordered_map>
+#include "triechildren.h"
+#include "doublearraytrie.h"
+#include <iterator>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
 
-struct TrieNode {
-    bool endOfWord;
-    std::unordered_map<char, TrieNode *> children;
-
-    TrieNode() : endOfWord(false) {}
+// One autocomplete result.
+struct Completion {
+    std::string word;
+    uint32_t weight;
 };
 
+// One fuzzy-search result: a stored word and its edit distance from the
+// query.
+struct FuzzyMatch {
+    std::string word;
+    size_t distance;
+};
 
-class Trie {
+// Prefix tree over characters. The Children policy (see triechildren.h)
+// decides how each node stores its child links, which sets both the node
+// size and the cost of one step down the tree.
+//
+// Each node also caches the highest word weight in its subtree, so
+// autocomplete() can expand the most promising branch first instead of
+// enumerating everything under the prefix, and the number of words in its
+// subtree, so countWithPrefix() never leaves the prefix path.
+//
+// Nodes are carved from fixed-size slabs owned by the trie and refer to
+// each other by 32-bit index. Index 0 is the root, which is never anyone's
+// child, so 0 also serves as the null link. Nodes freed by remove() go on
+// a free list for reuse, and destruction releases whole slabs at once.
+// Because a slab never moves, whole slabs can also be handed from one trie
+// to another, which is how buildParallel() joins the tries its threads
+// built.
+template <template <typename> class Children>
+class BasicTrie {
 private:
-    TrieNode* root;
+    struct Node {
+        bool endOfWord;
+        uint32_t weight;
+        uint32_t bestWeight;
+        uint32_t wordsBelow;
+        Children<uint32_t> children;
+
+        Node() : endOfWord(false), weight(0), bestWeight(0), wordsBelow(0) {}
+    };
+
+    static const size_t SLAB_SHIFT = 12;
+    static const size_t SLAB_NODES = size_t(1) << SLAB_SHIFT;
+
+    std::vector<Node*> slabs;
+    std::vector<uint32_t> freeNodes;
+    uint32_t nodesUsed;
+    size_t nodes;
 
-    bool removeHelper(TrieNode* node, const std::string& word, int depth);
-    void clear(TrieNode* node);
+    Node& nodeAt(uint32_t index) { return slabs[index >> SLAB_SHIFT][index & (SLAB_NODES - 1)]; }
+    const Node& nodeAt(uint32_t index) const { return slabs[index >> SLAB_SHIFT][index & (SLAB_NODES - 1)]; }
+
+    uint32_t allocateNode();
+    void padToSlabBoundary();
+    static void requireAccepted(std::string_view word);
+    void refreshBestWeight(Node& node);
+    bool removeHelper(uint32_t node, std::string_view word, int depth);
+    void collectWords(uint32_t node, std::string& prefix, std::vector<std::string>& words) const;
+    const Node* findNode(std::string_view word) const;
+    void fuzzyHelper(uint32_t node, std::string_view word, size_t maxEdits, std::vector<size_t>& rows,
+                     std::string& prefix, std::vector<FuzzyMatch>& matches) const;
+    void matchHelper(uint32_t node, std::string_view pattern, std::vector<size_t>& positions, size_t begin,
+                     std::vector<uint32_t>& marks, uint32_t& stamp, std::string& prefix,
+                     std::vector<std::string>& matches) const;
 
 public:
-    Trie();
-    ~Trie();
+    // Forward iterator over the words under one prefix, in key order for
+    // the layouts that keep children sorted. It walks the tree with an
+    // explicit stack and builds each word in one buffer it owns, so no
+    // allocation happens per word. The string_view it yields points into
+    // that buffer and is valid until the iterator is advanced. Changing
+    // the trie invalidates the iterator.
+    class PrefixIterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::string_view value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string_view* pointer;
+        typedef std::string_view reference;
+
+        // The end iterator.
+        PrefixIterator() : trie(nullptr) {}
+
+        std::string_view operator*() const { return buffer; }
+
+        PrefixIterator& operator++();
+        PrefixIterator operator++(int) { PrefixIterator old = *this; ++*this; return old; }
+
+        // Words are distinct, so two live iterators over one trie are at
+        // the same place exactly when they hold the same word.
+        bool operator==(const PrefixIterator& other) const {
+            return stack.empty() == other.stack.empty()
+                && (stack.empty() || (trie == other.trie && buffer == other.buffer));
+        }
+        bool operator!=(const PrefixIterator& other) const { return !(*this == other); }
+
+    private:
+        friend class BasicTrie;
+
+        // A node on the current path and the last child key taken from it
+        // (-1 before the first).
+        struct Frame {
+            uint32_t node;
+            int lastKey;
+        };
+
+        const BasicTrie* trie;
+        std::vector<Frame> stack;
+        std::string buffer;
+
+        PrefixIterator(const BasicTrie* trie, uint32_t start, std::string_view prefix);
+    };
+
+    // begin()/end() pair for a range-for over the words under a prefix.
+    class PrefixRange {
+    public:
+        PrefixIterator begin() const { return first; }
+        PrefixIterator end() const { return PrefixIterator(); }
+
+    private:
+        friend class BasicTrie;
+
+        PrefixIterator first;
 
-    void insert(const std::string& word);
-    void remove(const std::string& word);
-    bool search(const std::string& word);
-    bool startsWith(const std::string& prefix);
+        explicit PrefixRange(PrefixIterator first) : first(std::move(first)) {}
+    };
+
+    BasicTrie();
+    ~BasicTrie();
+
+    BasicTrie(const BasicTrie&) = delete;
+    BasicTrie& operator=(const BasicTrie&) = delete;
+
+    // Inserts word, or sets its weight if it is already present. Throws
+    // std::invalid_argument if the word holds a character the node layout
+    // cannot store; the trie is left unchanged.
+    void insert(std::string_view word, uint32_t weight = 1);
+
+    // Fills this trie, which must be empty, from words using up to
+    // threadCount threads; weights is parallel to words, or empty for all
+    // 1s. The words are grouped by first character and the groups dealt
+    // out largest first to the least loaded thread. Each thread builds a
+    // private trie with its own slabs, the links in those slabs are
+    // rebased to this trie's index space, again in parallel, and the slabs
+    // are then moved here with each group hung under the root. The result
+    // matches inserting the words in order. Throws like insert, before
+    // anything is built.
+    void buildParallel(const std::vector<std::string_view>& words, const std::vector<uint32_t>& weights,
+                       unsigned threadCount);
+
+    // Fills this trie, which must be empty, from words in key order, with
+    // weights as for buildParallel(). Keeps the path of the previous word
+    // on a stack, so each word costs only the nodes past its common prefix
+    // with the one before, and no child lookups at all. Subtree counts and
+    // maxima are summed as nodes leave the stack. Unsorted input is sorted
+    // first (a stable sort, so repeated words keep their last weight).
+    // Throws like insert, before anything is built.
+    void bulkLoadSorted(const std::vector<std::string_view>& words, const std::vector<uint32_t>& weights);
+    void remove(std::string_view word);
+    bool search(std::string_view word) const;
+    bool startsWith(std::string_view prefix) const;
+
+    // The k heaviest words starting with prefix, heaviest first; equal
+    // weights come out in key order. Best-first over the cached subtree
+    // maxima, so only branches that can still place are expanded.
+    std::vector<Completion> autocomplete(std::string_view prefix, size_t k) const;
+
+    // Stored words within maxEdits insertions, deletions or substitutions
+    // of word, closest first, ties in key order. The walk carries one
+    // Levenshtein DP row per depth and skips any subtree whose row minimum
+    // already exceeds maxEdits.
+    std::vector<FuzzyMatch> fuzzySearch(std::string_view word, size_t maxEdits) const;
+
+    // Stored words matching pattern, where '?' stands for any one character
+    // and '*' for any run of characters, including none. Each node carries
+    // the set of pattern positions still alive after reading its path, so
+    // no (node, position) pair is expanded twice however many '*'s lead to
+    // it, and a subtree is skipped once the set is empty. Key order for
+    // the sorted layouts.
+    std::vector<std::string> match(std::string_view pattern) const;
+
+    // The words starting with prefix, produced lazily: a caller that stops
+    // after n words pays for about n words of tree walking.
+    PrefixRange withPrefix(std::string_view prefix) const;
+
+    // Number of words starting with prefix, read from the subtree count at
+    // the end of the prefix path in O(|prefix|).
+    size_t countWithPrefix(std::string_view prefix) const;
+
+    // Number of words stored.
+    size_t size() const { return nodeAt(0).wordsBelow; }
+
+    // Number of child links a lookup for word follows.
+    size_t pathLength(std::string_view word) const;
+
+    // Every stored word, in key order for the layouts that keep children
+    // sorted (all but MapChildren).
+    std::vector<std::string> words() const;
+
+    // Read-only double-array copy of the words stored now. Later changes
+    // to this trie do not reach the copy.
+    DoubleArrayTrie freeze() const;
+
+    // Nodes currently in the tree, including the root.
+    size_t nodeCount() const { return nodes; }
+
+    static const char* layoutName() { return Children<uint32_t>::name(); }
 };
 
+// The default layout: with slab-allocated nodes and inline children, a
+// typical node needs no heap allocation of its own.
+typedef BasicTrie<SortedArrayChildren> Trie;
+typedef BasicTrie<MapChildren> MapTrie;
+typedef BasicTrie<DirectChildren> DirectTrie;
+typedef BasicTrie<BitmapChildren> BitmapTrie;
+
 #endif
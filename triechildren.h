@@ -0,0 +1,512 @@
+#ifndef TRIECHILDREN_H
+#define TRIECHILDREN_H
+
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using std::size_t;
+using std::unordered_map;
+
+// Child-storage policies for BasicTrie. Each policy is a class template
+// over the Link a node uses to reach a child, and Link() means "no child".
+// A policy provides find(), add() for a key that is not present yet,
+// erase(), size(), empty(), forEach(), nextAfter() and remap(), plus a
+// static accepts() that says which characters it can hold at all.
+
+namespace triedetail {
+
+inline unsigned popcount32(uint32_t bits) {
+#if defined(_MSC_VER)
+    return __popcnt(bits);
+#else
+    return (unsigned)__builtin_popcount(bits);
+#endif
+}
+
+// Position of c in 'a'..'z', or -1 for any other character.
+inline int letterIndex(char c) {
+    return (c >= 'a' && c <= 'z') ? c - 'a' : -1;
+}
+
+}
+
+// The original layout: a full hash map per node, with a bucket array and a
+// heap-allocated entry for every child.
+template <typename Link>
+class MapChildren {
+    public:
+    static const char* name() {
+        return "unordered_map";
+    }
+
+    static bool accepts(char) {
+        return true;
+    }
+
+    Link find(char c) const {
+        auto it = map_.find(c);
+        return it == map_.end() ? Link() : it->second;
+    }
+
+    void add(char c, Link child) {
+        map_.emplace(c, child);
+    }
+
+    void erase(char c) {
+        map_.erase(c);
+    }
+
+    size_t size() const {
+        return map_.size();
+    }
+
+    bool empty() const {
+        return map_.empty();
+    }
+
+    // Visits children in the map's order, not in key order.
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (const auto& pair : map_) {
+            visit(pair.first, pair.second);
+        }
+    }
+
+    // The child with the smallest key above after (as an unsigned char;
+    // -1 means the first child), or Link() if there is none. The map is
+    // unordered, so this scans every child.
+    Link nextAfter(int after, char& key) const {
+        Link best = Link();
+        int bestKey = 256;
+        for (const auto& pair : map_) {
+            int value = (unsigned char)pair.first;
+            if (value > after && value < bestKey) {
+                bestKey = value;
+                best = pair.second;
+            }
+        }
+        key = (char)bestKey;
+        return best;
+    }
+
+    // Replaces every child link l with map(l), keeping the keys.
+    template <typename Mapper>
+    void remap(Mapper map) {
+        for (auto& pair : map_) {
+            pair.second = map(pair.second);
+        }
+    }
+
+    private:
+    unordered_map<char, Link> map_;
+};
+
+// Keys kept sorted in a small array. Up to INLINE_CAPACITY children live
+// inside the node itself; a wider node moves to one heap block holding its
+// links followed by its keys, doubled as it fills. Almost every node has
+// one or two children, so almost none allocate.
+template <typename Link>
+class SortedArrayChildren {
+    public:
+    static const size_t INLINE_CAPACITY = 2;
+
+    static const char* name() {
+        return "sorted array";
+    }
+
+    static bool accepts(char) {
+        return true;
+    }
+
+    SortedArrayChildren() : count_(0), capacity_(INLINE_CAPACITY) {
+    }
+
+    ~SortedArrayChildren() {
+        if (onHeap()) {
+            ::operator delete(heapLinks_);
+        }
+    }
+
+    SortedArrayChildren(const SortedArrayChildren&) = delete;
+    SortedArrayChildren& operator=(const SortedArrayChildren&) = delete;
+
+    SortedArrayChildren(SortedArrayChildren&& other) noexcept {
+        takeFrom(other);
+    }
+
+    SortedArrayChildren& operator=(SortedArrayChildren&& other) noexcept {
+        if (this != &other) {
+            if (onHeap()) {
+                ::operator delete(heapLinks_);
+            }
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    Link find(char c) const {
+        const char* keys = keyArray();
+        for (size_t i = 0; i < count_; i++) {
+            if ((unsigned char)keys[i] >= (unsigned char)c) {
+                return keys[i] == c ? linkArray()[i] : Link();
+            }
+        }
+        return Link();
+    }
+
+    void add(char c, Link child) {
+        if (count_ == capacity_) {
+            grow();
+        }
+        char* keys = keyArray();
+        Link* links = linkArray();
+
+        size_t position = count_;
+        while (position > 0 && (unsigned char)keys[position - 1] > (unsigned char)c) {
+            keys[position] = keys[position - 1];
+            links[position] = links[position - 1];
+            position--;
+        }
+        keys[position] = c;
+        links[position] = child;
+        count_++;
+    }
+
+    void erase(char c) {
+        char* keys = keyArray();
+        Link* links = linkArray();
+        for (size_t i = 0; i < count_; i++) {
+            if (keys[i] == c) {
+                for (size_t j = i + 1; j < count_; j++) {
+                    keys[j - 1] = keys[j];
+                    links[j - 1] = links[j];
+                }
+                count_--;
+                return;
+            }
+        }
+    }
+
+    size_t size() const {
+        return count_;
+    }
+
+    bool empty() const {
+        return count_ == 0;
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        const char* keys = keyArray();
+        const Link* links = linkArray();
+        for (size_t i = 0; i < count_; i++) {
+            visit(keys[i], links[i]);
+        }
+    }
+
+    Link nextAfter(int after, char& key) const {
+        const char* keys = keyArray();
+        for (size_t i = 0; i < count_; i++) {
+            if ((unsigned char)keys[i] > after) {
+                key = keys[i];
+                return linkArray()[i];
+            }
+        }
+        return Link();
+    }
+
+    template <typename Mapper>
+    void remap(Mapper map) {
+        Link* links = linkArray();
+        for (size_t i = 0; i < count_; i++) {
+            links[i] = map(links[i]);
+        }
+    }
+
+    private:
+    uint16_t count_;
+    uint16_t capacity_;
+    char inlineKeys_[INLINE_CAPACITY];
+    union {
+        Link inlineLinks_[INLINE_CAPACITY];
+        Link* heapLinks_;
+    };
+
+    bool onHeap() const {
+        return capacity_ > INLINE_CAPACITY;
+    }
+
+    char* keyArray() {
+        return onHeap() ? reinterpret_cast<char*>(heapLinks_ + capacity_) : inlineKeys_;
+    }
+
+    const char* keyArray() const {
+        return onHeap() ? reinterpret_cast<const char*>(heapLinks_ + capacity_) : inlineKeys_;
+    }
+
+    Link* linkArray() {
+        return onHeap() ? heapLinks_ : inlineLinks_;
+    }
+
+    const Link* linkArray() const {
+        return onHeap() ? heapLinks_ : inlineLinks_;
+    }
+
+    void grow() {
+        size_t newCapacity = capacity_ * 2;
+        Link* block = static_cast<Link*>(::operator new(newCapacity * (sizeof(Link) + 1)));
+        char* newKeys = reinterpret_cast<char*>(block + newCapacity);
+
+        const char* keys = keyArray();
+        const Link* links = linkArray();
+        for (size_t i = 0; i < count_; i++) {
+            block[i] = links[i];
+            newKeys[i] = keys[i];
+        }
+
+        if (onHeap()) {
+            ::operator delete(heapLinks_);
+        }
+        heapLinks_ = block;
+        capacity_ = (uint16_t)newCapacity;
+    }
+
+    void takeFrom(SortedArrayChildren& other) {
+        count_ = other.count_;
+        capacity_ = other.capacity_;
+        if (other.onHeap()) {
+            heapLinks_ = other.heapLinks_;
+        } else {
+            for (size_t i = 0; i < other.count_; i++) {
+                inlineKeys_[i] = other.inlineKeys_[i];
+                inlineLinks_[i] = other.inlineLinks_[i];
+            }
+        }
+        other.count_ = 0;
+        other.capacity_ = INLINE_CAPACITY;
+    }
+};
+
+// One slot per lowercase letter, indexed directly. Lookups never search,
+// but every node pays for all 26 slots. Only 'a'..'z' are accepted.
+template <typename Link>
+class DirectChildren {
+    public:
+    static const size_t ALPHABET_SIZE = 26;
+
+    static const char* name() {
+        return "direct 26";
+    }
+
+    static bool accepts(char c) {
+        return triedetail::letterIndex(c) >= 0;
+    }
+
+    DirectChildren() : slots_(), count_(0) {
+    }
+
+    Link find(char c) const {
+        int index = triedetail::letterIndex(c);
+        return index < 0 ? Link() : slots_[index];
+    }
+
+    void add(char c, Link child) {
+        slots_[triedetail::letterIndex(c)] = child;
+        count_++;
+    }
+
+    void erase(char c) {
+        int index = triedetail::letterIndex(c);
+        if (index >= 0 && slots_[index] != Link()) {
+            slots_[index] = Link();
+            count_--;
+        }
+    }
+
+    size_t size() const {
+        return count_;
+    }
+
+    bool empty() const {
+        return count_ == 0;
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (size_t i = 0; i < ALPHABET_SIZE; i++) {
+            if (slots_[i] != Link()) {
+                visit((char)('a' + i), slots_[i]);
+            }
+        }
+    }
+
+    Link nextAfter(int after, char& key) const {
+        size_t i = after < 'a' ? 0 : (size_t)(after - 'a' + 1);
+        for (; i < ALPHABET_SIZE; i++) {
+            if (slots_[i] != Link()) {
+                key = (char)('a' + i);
+                return slots_[i];
+            }
+        }
+        return Link();
+    }
+
+    template <typename Mapper>
+    void remap(Mapper map) {
+        for (size_t i = 0; i < ALPHABET_SIZE; i++) {
+            if (slots_[i] != Link()) {
+                slots_[i] = map(slots_[i]);
+            }
+        }
+    }
+
+    private:
+    Link slots_[ALPHABET_SIZE];
+    uint8_t count_;
+};
+
+// A 32-bit presence bitmap over the letters plus a heap array holding only
+// the children that exist, in letter order. A child's position is the
+// popcount of the bits below its letter. Only 'a'..'z' are accepted.
+template <typename Link>
+class BitmapChildren {
+    public:
+    static const char* name() {
+        return "bitmap 32";
+    }
+
+    static bool accepts(char c) {
+        return triedetail::letterIndex(c) >= 0;
+    }
+
+    BitmapChildren() : bits_(0), links_(nullptr) {
+    }
+
+    ~BitmapChildren() {
+        delete[] links_;
+    }
+
+    BitmapChildren(const BitmapChildren&) = delete;
+    BitmapChildren& operator=(const BitmapChildren&) = delete;
+
+    BitmapChildren(BitmapChildren&& other) noexcept : bits_(other.bits_), links_(other.links_) {
+        other.bits_ = 0;
+        other.links_ = nullptr;
+    }
+
+    BitmapChildren& operator=(BitmapChildren&& other) noexcept {
+        if (this != &other) {
+            delete[] links_;
+            bits_ = other.bits_;
+            links_ = other.links_;
+            other.bits_ = 0;
+            other.links_ = nullptr;
+        }
+        return *this;
+    }
+
+    Link find(char c) const {
+        int index = triedetail::letterIndex(c);
+        if (index < 0) {
+            return Link();
+        }
+        uint32_t bit = 1u << index;
+        if (!(bits_ & bit)) {
+            return Link();
+        }
+        return links_[triedetail::popcount32(bits_ & (bit - 1))];
+    }
+
+    // The array is resized to fit exactly, so a node holds no spare slots.
+    void add(char c, Link child) {
+        uint32_t bit = 1u << triedetail::letterIndex(c);
+        size_t count = triedetail::popcount32(bits_);
+        size_t position = triedetail::popcount32(bits_ & (bit - 1));
+
+        Link* resized = new Link[count + 1];
+        for (size_t i = 0; i < position; i++) {
+            resized[i] = links_[i];
+        }
+        resized[position] = child;
+        for (size_t i = position; i < count; i++) {
+            resized[i + 1] = links_[i];
+        }
+
+        delete[] links_;
+        links_ = resized;
+        bits_ |= bit;
+    }
+
+    void erase(char c) {
+        int index = triedetail::letterIndex(c);
+        if (index < 0 || !(bits_ & (1u << index))) {
+            return;
+        }
+        uint32_t bit = 1u << index;
+        size_t count = triedetail::popcount32(bits_);
+        size_t position = triedetail::popcount32(bits_ & (bit - 1));
+
+        Link* resized = count > 1 ? new Link[count - 1] : nullptr;
+        for (size_t i = 0, j = 0; i < count; i++) {
+            if (i != position) {
+                resized[j++] = links_[i];
+            }
+        }
+
+        delete[] links_;
+        links_ = resized;
+        bits_ &= ~bit;
+    }
+
+    size_t size() const {
+        return triedetail::popcount32(bits_);
+    }
+
+    bool empty() const {
+        return bits_ == 0;
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        size_t position = 0;
+        for (int i = 0; i < 32; i++) {
+            if (bits_ & (1u << i)) {
+                visit((char)('a' + i), links_[position++]);
+            }
+        }
+    }
+
+    Link nextAfter(int after, char& key) const {
+        int first = after < 'a' ? 0 : after - 'a' + 1;
+        if (first >= 26) {
+            return Link();
+        }
+        uint32_t above = bits_ & ~((1u << first) - 1);
+        if (!above) {
+            return Link();
+        }
+        uint32_t bit = above & (~above + 1);
+        key = (char)('a' + triedetail::popcount32(bit - 1));
+        return links_[triedetail::popcount32(bits_ & (bit - 1))];
+    }
+
+    template <typename Mapper>
+    void remap(Mapper map) {
+        size_t count = triedetail::popcount32(bits_);
+        for (size_t i = 0; i < count; i++) {
+            links_[i] = map(links_[i]);
+        }
+    }
+
+    private:
+    uint32_t bits_;
+    Link* links_;
+};
+
+#endif
@@ -0,0 +1,180 @@
+#include "wordlist.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+inline bool isSpace(char c) {
+    return isspace((unsigned char)c) != 0;
+}
+
+inline bool isDigits(string_view token) {
+    for (char c : token) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+WordList::WordList(const string& path, unsigned threadCount)
+    : file_(path), arenaBytes_(0), weightedLines_(0), normalizedCount_(0) {
+    string_view text = file_.view();
+
+    // Cut points at roughly equal byte offsets, each pushed past the end
+    // of the line it falls in.
+    vector<size_t> cuts(1, 0);
+    threadCount = max(1u, threadCount);
+    for (unsigned t = 1; t < threadCount; t++) {
+        size_t cut = max(cuts.back(), text.size() / threadCount * t);
+        size_t lineEnd = text.find('\n', cut);
+        cut = lineEnd == string_view::npos ? text.size() : lineEnd + 1;
+        if (cut > cuts.back() && cut < text.size()) {
+            cuts.push_back(cut);
+        }
+    }
+    cuts.push_back(text.size());
+    chunkCount_ = cuts.size() - 1;
+
+    vector<Chunk> chunks(chunkCount_);
+    if (chunkCount_ == 1) {
+        chunks[0].tokenize(text);
+    } else {
+        vector<std::exception_ptr> failures(chunkCount_);
+        vector<thread> workers;
+        for (size_t c = 0; c < chunkCount_; c++) {
+            workers.push_back(thread([&, c]() {
+                try {
+                    chunks[c].tokenize(text.substr(cuts[c], cuts[c + 1] - cuts[c]));
+                } catch (...) {
+                    failures[c] = std::current_exception();
+                }
+            }));
+        }
+        for (thread& worker : workers) {
+            worker.join();
+        }
+        for (std::exception_ptr& failure : failures) {
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+        }
+    }
+
+    // Join in file order. Only the views move; the bytes they point at
+    // stay in the mapping or in arena blocks handed over below.
+    size_t total = 0;
+    for (const Chunk& chunk : chunks) {
+        total += chunk.words.size();
+    }
+    words_.reserve(total);
+    weights_.reserve(total);
+    for (Chunk& chunk : chunks) {
+        words_.insert(words_.end(), chunk.words.begin(), chunk.words.end());
+        weights_.insert(weights_.end(), chunk.weights.begin(), chunk.weights.end());
+        for (std::unique_ptr<char[]>& block : chunk.arena) {
+            arena_.push_back(std::move(block));
+        }
+        arenaBytes_ += chunk.arenaBytes;
+        weightedLines_ += chunk.weightedLines;
+        normalizedCount_ += chunk.normalizedCount;
+    }
+}
+
+void WordList::Chunk::tokenize(string_view text) {
+    // The fields of one line; reused so the scan allocates only to grow.
+    vector<string_view> fields;
+
+    size_t position = 0;
+    while (position < text.size()) {
+        size_t lineEnd = text.find('\n', position);
+        if (lineEnd == string_view::npos) {
+            lineEnd = text.size();
+        }
+
+        fields.clear();
+        while (position < lineEnd) {
+            while (position < lineEnd && isSpace(text[position])) {
+                position++;
+            }
+            size_t fieldStart = position;
+            while (position < lineEnd && !isSpace(text[position])) {
+                position++;
+            }
+            if (position > fieldStart) {
+                fields.push_back(text.substr(fieldStart, position - fieldStart));
+            }
+        }
+        position = lineEnd + 1;
+
+        uint32_t weight = 1;
+        if (fields.size() == 2 && isDigits(fields[1])) {
+            unsigned long long count = strtoull(string(fields[1]).c_str(), nullptr, 10);
+            weight = (uint32_t)min(count, (unsigned long long)UINT32_MAX);
+            fields.pop_back();
+            weightedLines++;
+        }
+        for (string_view field : fields) {
+            addWord(field, weight);
+        }
+    }
+}
+
+void WordList::Chunk::addWord(string_view token, uint32_t weight) {
+    size_t letters = 0;
+    bool clean = true;
+    for (char c : token) {
+        if (c >= 'a' && c <= 'z') {
+            letters++;
+        } else if (isalpha((unsigned char)c)) {
+            letters++;
+            clean = false;
+        } else {
+            clean = false;
+        }
+    }
+    if (letters == 0) {
+        return;
+    }
+
+    if (clean) {
+        words.push_back(token);
+    } else {
+        char* out = arenaSpace(letters);
+        size_t length = 0;
+        for (char c : token) {
+            if (isalpha((unsigned char)c)) {
+                out[length++] = (char)tolower((unsigned char)c);
+            }
+        }
+        words.push_back(string_view(out, length));
+        normalizedCount++;
+    }
+    weights.push_back(weight);
+}
+
+char* WordList::Chunk::arenaSpace(size_t length) {
+    // A word longer than a block gets a block of its own, after which the
+    // next word starts a fresh block.
+    if (length > ARENA_BLOCK) {
+        arena.push_back(std::unique_ptr<char[]>(new char[length]));
+        arenaBytes += length;
+        arenaUsed = ARENA_BLOCK;
+        return arena.back().get();
+    }
+    if (length > ARENA_BLOCK - arenaUsed) {
+        arena.push_back(std::unique_ptr<char[]>(new char[ARENA_BLOCK]));
+        arenaBytes += ARENA_BLOCK;
+        arenaUsed = 0;
+    }
+    char* space = arena.back().get() + arenaUsed;
+    arenaUsed += length;
+    return space;
+}
@@ -0,0 +1,104 @@
+#ifndef WORDLIST_H
+#define WORDLIST_H
+
+#include "mappedfile.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+// The words of a dataset file, tokenized in place in a memory mapping.
+// Tokens are split on whitespace, and a line holding exactly a word and a
+// number gives that word the number as its weight; every other word
+// weighs 1. Words keep only their letters, lowercased. A token that is
+// already all lowercase letters is returned as a view into the mapping;
+// only tokens that need changing are rewritten, into a side arena of
+// fixed blocks that never move. The views stay valid for the lifetime of
+// the WordList.
+//
+// With several threads the file is cut into that many byte ranges, each
+// moved forward to the next line start so that no line (and so no word or
+// "word count" pair) is split. Every thread tokenizes its range into its
+// own views and arena, and the per-range results are joined in file order
+// by copying views only.
+class WordList {
+    public:
+    // Throws std::runtime_error if the file cannot be mapped.
+    explicit WordList(const string& path, unsigned threadCount = 1);
+
+    WordList(const WordList&) = delete;
+    WordList& operator=(const WordList&) = delete;
+
+    const vector<string_view>& words() const {
+        return words_;
+    }
+
+    // Parallel to words().
+    const vector<uint32_t>& weights() const {
+        return weights_;
+    }
+
+    // Lines that carried a frequency column.
+    size_t weightedLines() const {
+        return weightedLines_;
+    }
+
+    // Words that had to be rewritten into the arena.
+    size_t normalizedCount() const {
+        return normalizedCount_;
+    }
+
+    size_t fileBytes() const {
+        return file_.size();
+    }
+
+    // Bytes of arena blocks allocated for rewritten words.
+    size_t arenaBytes() const {
+        return arenaBytes_;
+    }
+
+    // Byte ranges the file was split into.
+    size_t chunkCount() const {
+        return chunkCount_;
+    }
+
+    private:
+    static const size_t ARENA_BLOCK = 64 * 1024;
+
+    // What one thread produces from one byte range.
+    struct Chunk {
+        vector<string_view> words;
+        vector<uint32_t> weights;
+        vector<std::unique_ptr<char[]>> arena;
+        size_t arenaUsed;
+        size_t arenaBytes;
+        size_t weightedLines;
+        size_t normalizedCount;
+
+        Chunk() : arenaUsed(ARENA_BLOCK), arenaBytes(0), weightedLines(0), normalizedCount(0) {}
+
+        void tokenize(string_view text);
+        void addWord(string_view token, uint32_t weight);
+
+        // Room for length bytes that will not move when more are taken.
+        char* arenaSpace(size_t length);
+    };
+
+    MappedFile file_;
+    vector<string_view> words_;
+    vector<uint32_t> weights_;
+    vector<std::unique_ptr<char[]>> arena_;
+    size_t arenaBytes_;
+    size_t weightedLines_;
+    size_t normalizedCount_;
+    size_t chunkCount_;
+};
+
+#endif